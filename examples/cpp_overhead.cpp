@@ -0,0 +1,145 @@
+#include <swl.hpp>
+
+#include <Windows.h>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "user32.lib")
+#endif
+
+/*
+ * Compares swl.hpp against the raw C API doing the same work, to check the
+ * C++ layer costs nothing.
+ *
+ * dispatch: a switch over a large array of events versus swl::visit.
+ * drain: posted mouse moves read with swl_get_event one at a time versus the
+ * batched swl::events range.
+ */
+
+#define EVENTS (1 << 20)
+#define POSTED 5000
+#define ROUNDS 20
+
+static double now_ms() {
+	using namespace std::chrono;
+	return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static uint64_t handle_c(const swl_event_t& e) {
+	switch (e.type) {
+	case SWL_EVENT_KEYDOWN: return e.key.keycode;
+	case SWL_EVENT_KEYUP: return e.key.scancode;
+	case SWL_EVENT_MOUSEMOVE: return e.mouse_move.x + e.mouse_move.y;
+	case SWL_EVENT_MOUSEDOWN: return e.mouse_button.button;
+	case SWL_EVENT_RESIZED: return e.resize.w * e.resize.h;
+	default: return 1;
+	}
+}
+
+static uint64_t handle_cpp(const swl_event_t& e) {
+	uint64_t r = 1;
+	swl::visit(e, swl::overload{
+		[&](const swl::key_down& k) { r = k.keycode; },
+		[&](const swl::key_up& k) { r = k.scancode; },
+		[&](const swl::mouse_move& m) { r = m.x + m.y; },
+		[&](const swl::mouse_down& b) { r = b.button; },
+		[&](const swl::resized& s) { r = s.w * s.h; },
+	});
+	return r;
+}
+
+static void dispatch() {
+	static const swl_event_type_t types[] = {
+		SWL_EVENT_KEYDOWN, SWL_EVENT_KEYUP, SWL_EVENT_MOUSEMOVE, SWL_EVENT_MOUSEDOWN,
+		SWL_EVENT_MOUSEUP, SWL_EVENT_RESIZED, SWL_EVENT_PAINT,
+	};
+	std::vector<swl_event_t> events(EVENTS);
+	uint32_t seed = 1;
+	for (swl_event_t& e : events) {
+		seed = seed * 1103515245u + 12345u;
+		e.type = types[(seed >> 16) % (sizeof(types) / sizeof(types[0]))];
+		e.resize.w = seed & 0xFFF;
+		e.resize.h = seed >> 20;
+		e.resize.oldw = 0;
+		e.resize.oldh = 0;
+	}
+
+	double best_c = 1e9, best_cpp = 1e9;
+	uint64_t sum_c = 0, sum_cpp = 0;
+	for (int round = 0; round < ROUNDS; round++) {
+		/* alternate which runs first so neither always gets a warm cache */
+		for (int pass = 0; pass < 2; pass++) {
+			bool cpp = (round + pass) % 2 != 0;
+			double start = now_ms();
+			if (cpp) for (const swl_event_t& e : events) sum_cpp += handle_cpp(e);
+			else for (const swl_event_t& e : events) sum_c += handle_c(e);
+			double ms = now_ms() - start;
+			double& best = cpp ? best_cpp : best_c;
+			if (ms < best) best = ms;
+		}
+	}
+
+	std::printf("dispatch: C %.3f ns/event, C++ %.3f ns/event%s\n",
+		best_c * 1e6 / EVENTS, best_cpp * 1e6 / EVENTS,
+		sum_c == sum_cpp ? "" : " (results differ!)");
+}
+
+static void post(HWND hWnd) {
+	for (int i = 0; i < POSTED; i++)
+		PostMessageW(hWnd, WM_MOUSEMOVE, 0, MAKELPARAM(i & 0xFF, i >> 8));
+}
+
+static bool drain(HWND hWnd) {
+	double best_c = 1e9, best_cpp = 1e9;
+	uint64_t sum_c = 0, sum_cpp = 0;
+	for (int round = 0; round < ROUNDS; round++) {
+		post(hWnd);
+		double start = now_ms();
+		for (;;) {
+			swl_event_t e;
+			if (swl_get_event(&e) == false) return false;
+			if (e.type == SWL_EVENT_NONE) break;
+			sum_c += handle_c(e);
+		}
+		double end = now_ms();
+		if (end - start < best_c) best_c = end - start;
+
+		post(hWnd);
+		start = now_ms();
+		auto range = swl::events();
+		for (const swl_event_t& e : range) sum_cpp += handle_cpp(e);
+		end = now_ms();
+		if (range.ok() == false) return false;
+		if (end - start < best_cpp) best_cpp = end - start;
+	}
+
+	std::printf("drain:    C %.3f ns/event, C++ %.3f ns/event%s\n",
+		best_c * 1e6 / POSTED, best_cpp * 1e6 / POSTED,
+		sum_c == sum_cpp ? "" : " (results differ!)");
+	return true;
+}
+
+int main() {
+	dispatch();
+
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		std::printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	swl::window window = swl::window::create();
+	if (!window) {
+		std::printf("%s\n", swl_get_error());
+		return 1;
+	}
+	window.set_event_mask(SWL_EVENT_MASK(SWL_EVENT_MOUSEMOVE));
+	swl_dispatch_pending();
+
+	if (drain(static_cast<HWND>(window.native_handle())) == false) {
+		std::printf("%s\n", swl_get_error());
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include <swl.h>
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * Measures swap latency and frame-time jitter for a few swap intervals.
+ * Nothing is drawn, so this is purely the cost of presenting.
+ */
+
+#define FRAMES 240
+#define WARMUP 10
+
+static double now_ms(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void run(swl_gl_context_t* context, int interval) {
+	if (swl_set_swap_interval(context, interval) == false) {
+		printf("interval %2d: skipped (%s)\n", interval, swl_get_error());
+		return;
+	}
+
+	static double swap[FRAMES];
+	static double frame[FRAMES];
+	double last = 0;
+	for (int i = -WARMUP; i < FRAMES; i++) {
+		swl_dispatch_pending();
+		double start = now_ms();
+		swl_swap_buffers(context);
+		double end = now_ms();
+		if (i >= 0) {
+			swap[i] = end - start;
+			frame[i] = end - last;
+		}
+		last = end;
+	}
+
+	double swap_mean = 0, frame_mean = 0, jitter = 0;
+	for (int i = 0; i < FRAMES; i++) {
+		swap_mean += swap[i];
+		frame_mean += frame[i];
+	}
+	swap_mean /= FRAMES;
+	frame_mean /= FRAMES;
+	for (int i = 0; i < FRAMES; i++)
+		jitter += (frame[i] - frame_mean) * (frame[i] - frame_mean);
+	jitter = sqrt(jitter / FRAMES);
+
+	printf("interval %2d: swap %.3f ms, frame %.3f ms, jitter %.3f ms\n",
+		interval, swap_mean, frame_mean, jitter);
+}
+
+int main(int argc, char** argv) {
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	swl_window_t* window = swl_create_window();
+	if (window == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	swl_set_window_size(window, 640, 480);
+	swl_set_window_visible(window, true);
+
+	swl_gl_desc_t desc = {
+		.color_bits = 24,
+		.alpha_bits = 8,
+		.depth_bits = 24,
+	};
+	swl_gl_context_t* context = swl_create_gl_context(window, &desc);
+	if (context == NULL || swl_make_current(context) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	run(context, 0);
+	run(context, 1);
+	run(context, 2);
+	run(context, -1);
+
+	swl_destroy_gl_context(context);
+	return 0;
+}
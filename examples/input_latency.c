@@ -0,0 +1,264 @@
+#include <swl.h>
+
+#include <Windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "user32.lib")
+#endif
+
+/*
+ * Measures the time from injecting input into the OS to swl_get_event handing
+ * it to the application. A second thread injects key presses and mouse moves
+ * with SendInput at a fixed rate, from 1 Hz up to as fast as it can, and the
+ * main thread timestamps every event as it comes out of swl_get_event.
+ *
+ * Key presses are matched to injections in order. Mouse moves can be coalesced
+ * by Windows, so each one encodes its injection index modulo MOVE_SLOTS in its
+ * x coordinate and coalesced moves are counted rather than measured. Once moves
+ * fall MOVE_SLOTS behind, an arriving move could be any of several injections,
+ * so moves stop being measured and the rate is reported as aliased.
+ *
+ * A rate is sustainable if no key press is lost, moves never alias and the
+ * queue does not grow, i.e. key and move p99 latency stay under the injection
+ * period. The latency limits apply to every rate where the queue did not grow,
+ * sustainable or not; past that, latency only measures the backlog. The
+ * program exits with 1 if any of those rates is over a limit, or if no rate is
+ * sustainable.
+ *
+ * usage: input_latency [p99 limit us] [p999 limit us] [seconds per rate]
+ */
+
+#define MAX_SAMPLES 65536
+#define GRACE_US 250000
+#define MOVE_SLOTS 64
+#define MOVE_LEFT 32
+#define MOVE_X(k) (MOVE_LEFT + 4 * ((k) % MOVE_SLOTS))
+#define MOVE_Y 64
+
+typedef struct {
+	uint32_t rate;
+	uint32_t count;
+	POINT origin;
+	uint64_t sent[MAX_SAMPLES];
+	volatile LONG injected;
+	volatile LONG done;
+} injector_t;
+
+static injector_t injector;
+static uint64_t key_latency[MAX_SAMPLES];
+static uint64_t move_latency[MAX_SAMPLES];
+
+/* even samples are key presses, odd samples are mouse moves */
+static void inject(uint32_t n) {
+	INPUT in[2] = { 0 };
+	UINT count;
+	if (n % 2 == 0) {
+		in[0].type = INPUT_KEYBOARD;
+		in[0].ki.wVk = VK_F13;
+		in[1].type = INPUT_KEYBOARD;
+		in[1].ki.wVk = VK_F13;
+		in[1].ki.dwFlags = KEYEVENTF_KEYUP;
+		count = 2;
+	} else {
+		LONG cx = GetSystemMetrics(SM_CXSCREEN);
+		LONG cy = GetSystemMetrics(SM_CYSCREEN);
+		LONG x = injector.origin.x + MOVE_X(n / 2);
+		LONG y = injector.origin.y + MOVE_Y;
+		in[0].type = INPUT_MOUSE;
+		/* round up so the normalised position maps back to exactly x, y */
+		in[0].mi.dx = (x * 65536 + cx - 1) / cx;
+		in[0].mi.dy = (y * 65536 + cy - 1) / cy;
+		in[0].mi.dwFlags = MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE;
+		count = 1;
+	}
+
+	/* published before sending so the reader never sees an event first */
+	injector.sent[n] = swl_get_time();
+	InterlockedExchange(&injector.injected, n + 1);
+	SendInput(count, in, sizeof(INPUT));
+}
+
+static DWORD WINAPI inject_thread(LPVOID param) {
+	uint64_t start = swl_get_time();
+	for (uint32_t n = 0; n < injector.count; n++) {
+		if (injector.rate != 0) {
+			uint64_t due = start + (uint64_t)n * 1000000 / injector.rate;
+			for (uint64_t now = swl_get_time(); now < due; now = swl_get_time())
+				Sleep(due - now > 20000 ? 1 : 0);
+		}
+		inject(n);
+	}
+	InterlockedExchange(&injector.done, 1);
+	return 0;
+}
+
+static int compare(const void* a, const void* b) {
+	uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+	return x < y ? -1 : x > y;
+}
+
+static uint64_t percentile(const uint64_t* sorted, uint32_t n, double p) {
+	if (n == 0) return 0;
+	return sorted[(uint32_t)(p * (n - 1) + 0.5)];
+}
+
+typedef struct {
+	double achieved;
+	uint32_t keys, keys_lost, moves, moves_coalesced;
+	uint64_t key[3], move[3];
+	bool aliased;
+} result_t;
+
+static bool run(uint32_t rate, uint32_t seconds, result_t* r) {
+	uint32_t count = rate ? rate * seconds : MAX_SAMPLES;
+	if (count < 4) count = 4;
+	if (count > MAX_SAMPLES) count = MAX_SAMPLES;
+
+	injector.rate = rate;
+	injector.count = count;
+	injector.injected = 0;
+	injector.done = 0;
+
+	HANDLE thread = CreateThread(NULL, 0, inject_thread, NULL, 0, NULL);
+	if (thread == NULL) return false;
+
+	uint32_t keys = 0, moves = 0;
+	uint32_t next_key = 0;
+	int32_t last_move = -1;
+	bool aliased = false;
+	uint64_t finished = 0;
+	for (;;) {
+		swl_event_t e;
+		if (swl_get_event(&e) == false) return false;
+		uint64_t now = swl_get_time();
+
+		if (e.type == SWL_EVENT_KEYDOWN && e.key.keycode == VK_F13) {
+			if (next_key < count) key_latency[keys++] = now - injector.sent[next_key];
+			next_key += 2;
+		} else if (e.type == SWL_EVENT_MOUSEMOVE && aliased == false && e.mouse_move.y == MOVE_Y &&
+			e.mouse_move.x + 2 >= MOVE_LEFT && e.mouse_move.x < MOVE_LEFT + 4 * MOVE_SLOTS) {
+			/* the newest move sent to this x is the one that arrived */
+			int32_t slot = (e.mouse_move.x + 2 - MOVE_LEFT) / 4 % MOVE_SLOTS;
+			LONG injected = InterlockedCompareExchange(&injector.injected, 0, 0);
+			int32_t last = (injected - 2) / 2;
+			int32_t k = last - (int32_t)((uint32_t)(last - slot) % MOVE_SLOTS);
+			/* an older unmatched move with the same x could be the one that arrived */
+			if (injected >= 2 && k - MOVE_SLOTS > last_move) aliased = true;
+			/* windows can repeat a move without the mouse moving */
+			else if (injected >= 2 && k > last_move) {
+				move_latency[moves++] = now - injector.sent[2 * k + 1];
+				last_move = k;
+			}
+		} else if (e.type == SWL_EVENT_NONE) {
+			if (injector.done && finished == 0) finished = now;
+			if (finished && (next_key >= count || now - finished > GRACE_US)) break;
+			MsgWaitForMultipleObjectsEx(0, NULL, 1, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+		}
+	}
+
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+
+	uint64_t span = injector.sent[count - 1] - injector.sent[0];
+	r->achieved = span ? (count - 1) * 1000000.0 / span : 0;
+	r->keys = keys;
+	r->keys_lost = (count + 1) / 2 - keys;
+	r->moves = moves;
+	r->moves_coalesced = count / 2 - moves;
+	r->aliased = aliased;
+
+	qsort(key_latency, keys, sizeof(uint64_t), compare);
+	qsort(move_latency, moves, sizeof(uint64_t), compare);
+	r->key[0] = percentile(key_latency, keys, 0.5);
+	r->key[1] = percentile(key_latency, keys, 0.99);
+	r->key[2] = percentile(key_latency, keys, 0.999);
+	r->move[0] = percentile(move_latency, moves, 0.5);
+	r->move[1] = percentile(move_latency, moves, 0.99);
+	r->move[2] = percentile(move_latency, moves, 0.999);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	uint64_t p99_limit = argc > 1 ? strtoull(argv[1], NULL, 10) : 2000;
+	uint64_t p999_limit = argc > 2 ? strtoull(argv[2], NULL, 10) : 10000;
+	uint32_t seconds = argc > 3 ? atoi(argv[3]) : 3;
+	/* 0 means as fast as the injecting thread can go */
+	static const uint32_t rates[] = { 1, 10, 100, 1000, 10000, 0 };
+
+	/* keep SendInput coordinates in physical pixels */
+	SetProcessDPIAware();
+
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	swl_window_t* window = swl_create_window();
+	if (window == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	swl_set_window_title(window, "input latency");
+	swl_set_window_size(window, 512, 384);
+	swl_set_window_visible(window, true);
+	swl_set_event_mask(window, SWL_EVENT_MASK(SWL_EVENT_KEYDOWN) | SWL_EVENT_MASK(SWL_EVENT_MOUSEMOVE));
+	swl_dispatch_pending();
+
+	/* injected input goes to the foreground window, so that has to be ours */
+	HWND hWnd = GetForegroundWindow();
+	if (hWnd == NULL || GetWindowThreadProcessId(hWnd, NULL) != GetCurrentThreadId()) {
+		printf("The test window did not get focus.\n");
+		return 1;
+	}
+	injector.origin.x = 0;
+	injector.origin.y = 0;
+	ClientToScreen(hWnd, &injector.origin);
+
+	printf("    rate  achieved |  key p50    p99   p999 lost | move p50    p99   p999 coalesced\n");
+
+	double sustainable = 0;
+	bool failed = false;
+	for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+		result_t r;
+		if (run(rates[i], seconds, &r) == false) {
+			printf("%s\n", swl_get_error());
+			return 1;
+		}
+
+		char name[16];
+		if (rates[i]) snprintf(name, sizeof(name), "%u", rates[i]);
+		else snprintf(name, sizeof(name), "max");
+
+		double period = r.achieved > 0 ? 1000000.0 / r.achieved : 0;
+		bool kept_up = r.keys > 0 && r.key[1] < period && (r.moves == 0 || r.move[1] < period);
+		bool ok = kept_up && r.keys_lost == 0 && r.aliased == false;
+		bool over = r.key[1] > p99_limit || r.move[1] > p99_limit ||
+			r.key[2] > p999_limit || r.move[2] > p999_limit;
+		if (ok && r.achieved > sustainable) sustainable = r.achieved;
+		if (kept_up && over) failed = true;
+
+		const char* status = "";
+		if (kept_up == false) status = "saturated";
+		else if (over) status = "OVER LIMIT";
+		else if (r.aliased) status = "aliased";
+		else if (r.keys_lost) status = "lost keys";
+
+		printf("%8s %9.0f | %6llu %6llu %6llu %4u | %8llu %6llu %6llu %9u %s\n",
+			name, r.achieved,
+			(unsigned long long)r.key[0], (unsigned long long)r.key[1],
+			(unsigned long long)r.key[2], r.keys_lost,
+			(unsigned long long)r.move[0], (unsigned long long)r.move[1],
+			(unsigned long long)r.move[2], r.moves_coalesced,
+			status);
+	}
+
+	printf("latency in us, max sustainable rate %.0f Hz\n", sustainable);
+	if (sustainable == 0) printf("No rate was sustainable.\n");
+	if (failed) {
+		printf("Latency above p99 %llu us / p999 %llu us.\n",
+			(unsigned long long)p99_limit, (unsigned long long)p999_limit);
+	}
+	return sustainable == 0 || failed;
+}
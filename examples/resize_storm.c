@@ -0,0 +1,271 @@
+#include <swl.h>
+
+#include <Windows.h>
+#include <stdio.h>
+
+#ifdef _MSC_VER
+#pragma comment(lib, "user32.lib")
+#pragma comment(lib, "gdi32.lib")
+#endif
+
+/*
+ * Resizes a window over and over and reports how long it takes until the
+ * window shows pixels of the right size, for each live resize mode. Every
+ * sample is checked by reading the bottom right pixel back from the window, so
+ * a paint that did not happen is not counted as one.
+ *
+ * set size: swl_set_window_size, then one swl_dispatch_pending, which is where
+ * live resize paints, then a full frame. This never enters the Win32 size-move
+ * loop, so it times the paint path on its own. Samples that were not painted
+ * by live resize count the time to the full frame.
+ *
+ * drag: a second thread drags the bottom right corner with SendInput while the
+ * main thread sits in the size-move loop, where the application cannot render
+ * and only gets SWL_EVENT_RESIZING. This is the case live resize exists for.
+ * With it off the corner is not right until the drag ends, so those steps are
+ * counted as missed rather than timed. Needs the window to have focus.
+ *
+ * Frames have a solid border in a colour that changes every frame, so a
+ * rescaled frame can be told apart from what was on screen before. Crop keeps
+ * the frame where it was, so a shrinking crop looks the same painted or not;
+ * growing, it has to show black where the frame ends.
+ */
+
+#define RESIZES 100
+#define BORDER 8
+#define DRAG_STEPS 40
+#define DRAG_STEP 8
+#define PAINT_TIMEOUT 100000
+
+typedef struct {
+	uint32_t color;
+	uint32_t w, h;
+} frame_t;
+
+/* stands in for an expensive scene */
+static uint32_t pixel(const frame_t* frame, uint32_t x, uint32_t y) {
+	if (x + BORDER >= frame->w || y + BORDER >= frame->h) return frame->color;
+	uint32_t v = x * 2654435761u ^ y * 40503u;
+	for (int i = 0; i < 32; i++) v = v * 1103515245u + 12345u;
+	return v & 0x00FFFFFF;
+}
+
+static void scene(void* user, uint32_t* pixels, uint32_t stride, const swl_rect_t* tile) {
+	for (uint32_t y = tile->y0; y < tile->y1; y++) {
+		uint32_t* row = pixels + (y - tile->y0) * stride;
+		for (uint32_t x = tile->x0; x < tile->x1; x++)
+			row[x - tile->x0] = pixel(user, x, y);
+	}
+}
+
+static bool render(swl_compositor_t* compositor, HWND hWnd, frame_t* frame) {
+	RECT rc;
+	GetClientRect(hWnd, &rc);
+	frame->color = frame->color == 0x00FF8000 ? 0x000080FF : 0x00FF8000;
+	frame->w = rc.right;
+	frame->h = rc.bottom;
+	return swl_compositor_render(compositor, scene, frame);
+}
+
+/* whether the bottom right pixel is what mode makes of the last frame */
+static bool painted(HWND hWnd, swl_live_resize_t mode, const frame_t* frame, SIZE* size) {
+	RECT rc;
+	if (GetClientRect(hWnd, &rc) == 0 || rc.right == 0 || rc.bottom == 0) return false;
+	uint32_t w = rc.right, h = rc.bottom;
+	if (size != NULL) {
+		size->cx = w;
+		size->cy = h;
+	}
+
+	uint32_t want = frame->color;
+	if (mode == SWL_LIVE_RESIZE_CROP)
+		want = w > frame->w || h > frame->h ? 0 : pixel(frame, w - 1, h - 1);
+
+	HDC hDC = GetDC(hWnd);
+	COLORREF c = GetPixel(hDC, w - 1, h - 1);
+	ReleaseDC(hWnd, hDC);
+	return c == RGB(want >> 16 & 0xFF, want >> 8 & 0xFF, want & 0xFF);
+}
+
+static uint32_t drain(void) {
+	uint32_t resizing = 0;
+	swl_event_t e;
+	do {
+		swl_get_event(&e);
+		if (e.type == SWL_EVENT_RESIZING) resizing++;
+	} while (e.type != SWL_EVENT_NONE);
+	return resizing;
+}
+
+static bool set_size(swl_window_t* window, swl_compositor_t* compositor, HWND hWnd, swl_live_resize_t mode, const char* name) {
+	frame_t frame = { 0 };
+	swl_set_window_size(window, 800, 600);
+	drain();
+	if (render(compositor, hWnd, &frame) == false) return false;
+
+	double first = 0, full = 0;
+	uint32_t rescaled = 0;
+	for (int i = 0; i < RESIZES; i++) {
+		uint32_t w = 640 + (i * 37) % 640;
+		uint32_t h = 480 + (i * 23) % 360;
+
+		uint64_t t0 = swl_get_time();
+		swl_set_window_size(window, w, h);
+		/* live resize paints from inside the paint message */
+		swl_dispatch_pending();
+		uint64_t t1 = swl_get_time();
+		bool ok = mode != SWL_LIVE_RESIZE_OFF && painted(hWnd, mode, &frame, NULL);
+		drain();
+		if (render(compositor, hWnd, &frame) == false) return false;
+		uint64_t t2 = swl_get_time();
+
+		first += ok ? t1 - t0 : t2 - t0;
+		full += t2 - t0;
+		if (ok) rescaled++;
+	}
+
+	printf("set size %-8s first correct pixels %7.3f ms, full frame %7.3f ms, painted %u/%u\n",
+		name, first / 1000.0 / RESIZES, full / 1000.0 / RESIZES, rescaled, RESIZES);
+	return true;
+}
+
+typedef struct {
+	HWND hWnd;
+	swl_live_resize_t mode;
+	const frame_t* frame;
+	uint64_t total;
+	uint32_t painted;
+	volatile LONG done;
+} drag_t;
+
+static void mouse(LONG x, LONG y, DWORD flags) {
+	LONG cx = GetSystemMetrics(SM_CXSCREEN);
+	LONG cy = GetSystemMetrics(SM_CYSCREEN);
+	INPUT in = { 0 };
+	in.type = INPUT_MOUSE;
+	/* round up so the normalised position maps back to exactly x, y */
+	in.mi.dx = (x * 65536 + cx - 1) / cx;
+	in.mi.dy = (y * 65536 + cy - 1) / cy;
+	in.mi.dwFlags = MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE | flags;
+	SendInput(1, &in, sizeof(INPUT));
+}
+
+static DWORD WINAPI drag_thread(LPVOID param) {
+	drag_t* drag = param;
+	RECT rc;
+	GetWindowRect(drag->hWnd, &rc);
+	/* inside the resize border, which extends past the visible frame */
+	LONG x = rc.right - 2, y = rc.bottom - 2;
+	SIZE size = { 0 }, last = { 0 };
+	painted(drag->hWnd, drag->mode, drag->frame, &last);
+
+	mouse(x, y, 0);
+	Sleep(50);
+	mouse(x, y, MOUSEEVENTF_LEFTDOWN);
+	Sleep(50);
+	for (int i = 0; i < DRAG_STEPS; i++) {
+		/* grow, then shrink back below where it started */
+		LONG step = i < DRAG_STEPS / 3 ? DRAG_STEP : -DRAG_STEP;
+		x += step;
+		y += step;
+		uint64_t t0 = swl_get_time();
+		mouse(x, y, 0);
+		for (uint64_t now = t0; now - t0 < PAINT_TIMEOUT; now = swl_get_time()) {
+			/* the old size still shows the old pixels, so wait for the new one */
+			if (painted(drag->hWnd, drag->mode, drag->frame, &size) &&
+				(size.cx != last.cx || size.cy != last.cy)) {
+				drag->total += swl_get_time() - t0;
+				drag->painted++;
+				break;
+			}
+		}
+		last = size;
+	}
+
+	mouse(x, y, MOUSEEVENTF_LEFTUP);
+	InterlockedExchange(&drag->done, 1);
+	return 0;
+}
+
+static bool drag(swl_window_t* window, swl_compositor_t* compositor, HWND hWnd, swl_live_resize_t mode, const char* name) {
+	frame_t frame = { 0 };
+	swl_set_window_size(window, 640, 480);
+	swl_set_window_pos(window, 100, 100);
+	drain();
+	if (render(compositor, hWnd, &frame) == false) return false;
+
+	drag_t state = { hWnd, mode, &frame };
+	HANDLE thread = CreateThread(NULL, 0, drag_thread, &state, 0, NULL);
+	if (thread == NULL) return false;
+
+	/* the size-move loop runs inside this until the button comes up */
+	uint32_t resizing = 0;
+	while (state.done == 0) {
+		swl_dispatch_pending();
+		resizing += drain();
+		MsgWaitForMultipleObjectsEx(0, NULL, 10, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+	}
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+	swl_dispatch_pending();
+	resizing += drain();
+
+	printf("drag     %-8s first correct pixels %7.3f ms, painted %u/%u, resizing events %u\n",
+		name, state.painted ? state.total / 1000.0 / state.painted : 0.0,
+		state.painted, DRAG_STEPS, resizing);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	static const char* names[] = { "off", "nearest", "bilinear", "crop" };
+
+	/* keep SendInput and GetWindowRect in the same physical pixels */
+	SetProcessDPIAware();
+
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	swl_window_t* window = swl_create_window();
+	if (window == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	swl_set_window_resizable(window, true);
+	swl_set_window_size(window, 800, 600);
+	swl_set_window_visible(window, true);
+	swl_dispatch_pending();
+	HWND hWnd = swl_get_window_handle_raw(window);
+
+	swl_compositor_t* compositor = swl_create_compositor(window, 0);
+	if (compositor == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	for (int mode = SWL_LIVE_RESIZE_OFF; mode <= SWL_LIVE_RESIZE_CROP; mode++) {
+		swl_set_window_live_resize(window, mode);
+		if (set_size(window, compositor, hWnd, mode, names[mode]) == false) {
+			printf("%s\n", swl_get_error());
+			return 1;
+		}
+	}
+
+	/* injected input goes to the foreground window, so that has to be ours */
+	HWND foreground = GetForegroundWindow();
+	if (foreground == NULL || GetWindowThreadProcessId(foreground, NULL) != GetCurrentThreadId()) {
+		printf("drag skipped, the test window did not get focus.\n");
+	} else {
+		for (int mode = SWL_LIVE_RESIZE_OFF; mode <= SWL_LIVE_RESIZE_CROP; mode++) {
+			swl_set_window_live_resize(window, mode);
+			if (drag(window, compositor, hWnd, mode, names[mode]) == false) {
+				printf("%s\n", swl_get_error());
+				return 1;
+			}
+		}
+	}
+
+	swl_destroy_compositor(compositor);
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <swl.h>
+
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Times swl startup, phase by phase. Optional libraries are loaded the first
+ * time a feature needs them, so those phases show up where they are used
+ * instead of in swl_init.
+ */
+
+static double now_ms(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static double phase(const char* name, double start) {
+	double end = now_ms();
+	printf("%-24s %8.3f ms\n", name, end - start);
+	return end;
+}
+
+int main(int argc, char** argv) {
+	double start = now_ms();
+	double t = start;
+
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	t = phase("swl_init", t);
+
+	swl_window_t* window = swl_create_window();
+	if (window == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	t = phase("first window", t);
+
+	swl_set_window_visible(window, true);
+	swl_dispatch_pending();
+	t = phase("first show", t);
+
+	swl_set_window_transparent(window, true);
+	t = phase("first transparency", t);
+
+	swl_gl_desc_t desc = { .color_bits = 24 };
+	swl_gl_context_t* context = swl_create_gl_context(window, &desc);
+	t = phase("first GL context", t);
+	if (context) swl_destroy_gl_context(context);
+
+	swl_window_t* second = swl_create_window();
+	if (second == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	t = phase("second window", t);
+
+	printf("%-24s %8.3f ms\n", "total", t - start);
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <swl.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Measures how the tiled compositor scales with threads. Every frame damages
+ * the whole window and fills it with a shader that does a bit of arithmetic
+ * per pixel, so the work is CPU bound rather than memory bound.
+ *
+ * usage: tile_scaling [max threads] [width] [height]
+ */
+
+#define FRAMES 30
+
+static double now_ms(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void shade(void* user, uint32_t* pixels, uint32_t stride, const swl_rect_t* tile) {
+	uint32_t frame = *(uint32_t*)user;
+	for (uint32_t y = tile->y0; y < tile->y1; y++) {
+		uint32_t* row = pixels + (y - tile->y0) * stride;
+		for (uint32_t x = tile->x0; x < tile->x1; x++) {
+			uint32_t v = x * 2654435761u ^ y * 40503u ^ frame;
+			for (int i = 0; i < 8; i++) v = v * 1103515245u + 12345u;
+			row[x - tile->x0] = v & 0x00FFFFFF;
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	uint32_t max_threads = argc > 1 ? atoi(argv[1]) : 16;
+	uint32_t width = argc > 2 ? atoi(argv[2]) : 3840;
+	uint32_t height = argc > 3 ? atoi(argv[3]) : 2160;
+
+	if (swl_init(SWL_BACKEND_ANY) == false) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+
+	swl_window_t* window = swl_create_window();
+	if (window == NULL) {
+		printf("%s\n", swl_get_error());
+		return 1;
+	}
+	swl_set_window_borderless(window, true);
+	swl_set_window_size(window, width, height);
+	swl_set_window_visible(window, true);
+	swl_dispatch_pending();
+
+	swl_rect_t all = { 0, 0, width, height };
+	double base = 0;
+	for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+		swl_compositor_t* compositor = swl_create_compositor(window, threads);
+		if (compositor == NULL) {
+			printf("%s\n", swl_get_error());
+			return 1;
+		}
+
+		uint32_t frame = 0;
+		swl_compositor_render(compositor, shade, &frame);
+
+		double start = now_ms();
+		for (frame = 1; frame <= FRAMES; frame++) {
+			swl_dispatch_pending();
+			swl_compositor_damage(compositor, &all, 1);
+			swl_compositor_render(compositor, shade, &frame);
+		}
+		double ms = (now_ms() - start) / FRAMES;
+		if (threads == 1) base = ms;
+
+		printf("%2u threads: %8.3f ms/frame, speedup %.2fx\n", threads, ms, base / ms);
+		swl_destroy_compositor(compositor);
+	}
+
+	return 0;
+}
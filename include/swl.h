@@ -13,6 +13,8 @@
 #include <stdbool.h>
 
 typedef struct swl_window_t swl_window_t;
+typedef struct swl_gl_context_t swl_gl_context_t;
+typedef struct swl_compositor_t swl_compositor_t;
 
 typedef enum {
 	SWL_EVENT_NONE,
@@ -27,6 +29,9 @@ typedef enum {
 	SWL_EVENT_PAINT,
 } swl_event_type_t;
 
+#define SWL_EVENT_MASK(type) (1u << (type))
+#define SWL_EVENT_MASK_ALL 0xFFFFFFFFu
+
 typedef enum {
 	SWL_BACKEND_ANY,
 	SWL_BACKEND_WIN32,
@@ -67,6 +72,83 @@ typedef struct {
 	};
 } swl_event_t;
 
+typedef struct {
+	uint32_t x0;
+	uint32_t y0;
+	uint32_t x1;
+	uint32_t y1;
+} swl_rect_t;
+
+typedef enum {
+	SWL_LIVE_RESIZE_OFF,
+	SWL_LIVE_RESIZE_NEAREST,
+	SWL_LIVE_RESIZE_BILINEAR,
+	SWL_LIVE_RESIZE_CROP,
+} swl_live_resize_t;
+
+typedef void (*swl_tile_fn_t)(void* user, uint32_t* pixels, uint32_t stride, const swl_rect_t* tile);
+
+typedef struct {
+	uint64_t queued;
+	uint64_t dropped;
+	uint64_t lost;
+} swl_event_stats_t;
+
+typedef struct {
+	uint32_t major;
+	uint32_t minor;
+	bool core_profile;
+	bool debug;
+	uint8_t color_bits;
+	uint8_t alpha_bits;
+	uint8_t depth_bits;
+	uint8_t stencil_bits;
+	uint8_t samples;
+	bool srgb;
+} swl_gl_desc_t;
+
+typedef struct {
+	uint64_t frame;
+	uint64_t predicted_present;
+	uint64_t input_deadline;
+	uint64_t refresh_period;
+	bool feedback;
+} swl_frame_t;
+
+typedef struct {
+	uint64_t frames;
+	uint64_t missed;
+	uint64_t confirmed;
+	uint64_t latency_avg;
+	uint64_t latency_max;
+	uint64_t render_avg;
+} swl_frame_stats_t;
+
+typedef struct {
+	uint64_t arena_reserve;
+	uint64_t arena_commit;
+} swl_memory_config_t;
+
+typedef enum {
+	SWL_MEMORY_WINDOWS,
+	SWL_MEMORY_EVENTS,
+	SWL_MEMORY_GL,
+	SWL_MEMORY_SCRATCH,
+	SWL_MEMORY_COMPOSITOR,
+	SWL_MEMORY_COUNT,
+} swl_memory_subsystem_t;
+
+typedef struct {
+	uint64_t reserved;
+	uint64_t committed;
+	uint64_t live;
+} swl_memory_usage_t;
+
+typedef struct {
+	swl_memory_usage_t subsystem[SWL_MEMORY_COUNT];
+	swl_memory_usage_t total;
+} swl_memory_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -74,6 +156,7 @@ extern "C" {
 bool swl_init(swl_backend_t backend);
 swl_backend_t swl_get_backend(void);
 swl_window_t* swl_create_window(void);
+bool swl_destroy_window(swl_window_t* window);
 bool swl_set_window_title(swl_window_t* window, const char* title);
 bool swl_set_window_size(swl_window_t* window, uint32_t x, uint32_t y);
 bool swl_set_window_pos(swl_window_t* window, uint32_t x, uint32_t y);
@@ -90,7 +173,31 @@ bool swl_get_window_borderless(swl_window_t* window, bool* borderless);
 bool swl_get_window_visible(swl_window_t* window, bool* visible);
 void* swl_get_window_handle_raw(swl_window_t* window);
 bool swl_get_event(swl_event_t* event);
+bool swl_get_events(swl_event_t* events, uint32_t max, uint32_t* count);
 bool swl_wait_event(void);
+bool swl_dispatch_pending(void);
+int swl_get_poll_fd(void);
+bool swl_set_event_mask(swl_window_t* window, uint32_t mask);
+bool swl_get_event_mask(swl_window_t* window, uint32_t* mask);
+bool swl_get_event_stats(swl_event_stats_t* stats);
+swl_gl_context_t* swl_create_gl_context(swl_window_t* window, const swl_gl_desc_t* desc);
+bool swl_destroy_gl_context(swl_gl_context_t* context);
+bool swl_make_current(swl_gl_context_t* context);
+bool swl_swap_buffers(swl_gl_context_t* context);
+bool swl_set_swap_interval(swl_gl_context_t* context, int interval);
+uint64_t swl_get_time(void);
+bool swl_frame_begin(swl_window_t* window, swl_frame_t* frame);
+bool swl_frame_end(swl_window_t* window, bool* on_time);
+bool swl_get_frame_stats(swl_window_t* window, swl_frame_stats_t* stats);
+swl_compositor_t* swl_create_compositor(swl_window_t* window, uint32_t threads);
+bool swl_destroy_compositor(swl_compositor_t* compositor);
+bool swl_compositor_damage(swl_compositor_t* compositor, const swl_rect_t* rects, uint32_t count);
+bool swl_compositor_render(swl_compositor_t* compositor, swl_tile_fn_t fn, void* user);
+bool swl_set_window_live_resize(swl_window_t* window, swl_live_resize_t mode);
+bool swl_get_window_live_resize(swl_window_t* window, swl_live_resize_t* mode);
+bool swl_set_memory_config(const swl_memory_config_t* config);
+bool swl_trim_memory(void);
+bool swl_get_memory_stats(swl_memory_stats_t* stats);
 const char* swl_get_error(void);
 
 #ifdef INTERNAL
@@ -110,17 +217,37 @@ void* swl_push_arena(swl_arena_t* arena, ptrdiff_t amnt);
 void swl_pop_arena(swl_arena_t* arena, ptrdiff_t amnt);
 void swl_clear_arena(swl_arena_t* arena);
 void swl_free_arena(swl_arena_t* arena);
+void swl_trim_arena(swl_arena_t* arena);
 
 typedef struct {
 	swl_arena_t arena;
 	void* free_list;
 	ptrdiff_t size;
+	ptrdiff_t live;
 } swl_pool_t;
 
 swl_pool_t swl_new_pool(ptrdiff_t size);
 void* swl_pool_alloc(swl_pool_t* pool);
 void swl_pool_free(swl_pool_t* pool, void* ptr);
 void swl_free_pool(swl_pool_t* pool);
+void swl_trim_pool(swl_pool_t* pool);
+
+typedef struct swl_tracked_t {
+	struct swl_tracked_t* next;
+	swl_arena_t* arena;
+	swl_pool_t* pool;
+	swl_memory_subsystem_t subsystem;
+	/* bytes the owner allocated outside of the arena */
+	ptrdiff_t external;
+	/* called by swl_trim_memory to drop caches, may be NULL */
+	void (*trim)(void* user);
+	void* user;
+} swl_tracked_t;
+
+extern swl_memory_config_t swl_memory_config;
+void swl_track_arena(swl_tracked_t* node, swl_arena_t* arena, swl_memory_subsystem_t subsystem);
+void swl_track_pool(swl_tracked_t* node, swl_pool_t* pool, swl_memory_subsystem_t subsystem);
+void swl_untrack(swl_tracked_t* node);
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,240 @@
+#ifndef _SWL_HPP_
+#define _SWL_HPP_
+
+/*
+ * Header-only C++20 layer over swl.h. Nothing here allocates or throws; every
+ * function is an inline forward to the C API, so failures are reported the
+ * same way, through return values and swl_get_error.
+ *
+ * Handles own what they point to and destroy it when they go out of scope.
+ * Declare a window before its compositor and GL contexts, so they are
+ * destroyed first.
+ */
+
+#include <swl.h>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+namespace swl {
+
+template <class T, bool (*Destroy)(T*)>
+class handle {
+public:
+	handle() noexcept = default;
+	explicit handle(T* ptr) noexcept : ptr_(ptr) {}
+	handle(const handle&) = delete;
+	handle& operator=(const handle&) = delete;
+	handle(handle&& other) noexcept : ptr_(other.release()) {}
+	handle& operator=(handle&& other) noexcept {
+		reset(other.release());
+		return *this;
+	}
+	~handle() { reset(); }
+
+	T* get() const noexcept { return ptr_; }
+	explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+	T* release() noexcept {
+		T* ptr = ptr_;
+		ptr_ = nullptr;
+		return ptr;
+	}
+
+	void reset(T* ptr = nullptr) noexcept {
+		T* old = ptr_;
+		ptr_ = ptr;
+		if (old != nullptr) Destroy(old);
+	}
+
+private:
+	T* ptr_ = nullptr;
+};
+
+class window : public handle<swl_window_t, swl_destroy_window> {
+public:
+	using handle::handle;
+
+	/* empty if creation failed */
+	static window create() noexcept { return window(swl_create_window()); }
+
+	bool set_title(const char* title) const noexcept { return swl_set_window_title(get(), title); }
+	bool set_size(uint32_t x, uint32_t y) const noexcept { return swl_set_window_size(get(), x, y); }
+	bool set_pos(uint32_t x, uint32_t y) const noexcept { return swl_set_window_pos(get(), x, y); }
+	bool set_resizable(bool resizable) const noexcept { return swl_set_window_resizable(get(), resizable); }
+	bool set_transparent(bool transparent) const noexcept { return swl_set_window_transparent(get(), transparent); }
+	bool set_borderless(bool borderless) const noexcept { return swl_set_window_borderless(get(), borderless); }
+	bool set_visible(bool visible) const noexcept { return swl_set_window_visible(get(), visible); }
+	bool set_event_mask(uint32_t mask) const noexcept { return swl_set_event_mask(get(), mask); }
+	bool set_live_resize(swl_live_resize_t mode) const noexcept { return swl_set_window_live_resize(get(), mode); }
+	void* native_handle() const noexcept { return swl_get_window_handle_raw(get()); }
+};
+
+using compositor = handle<swl_compositor_t, swl_destroy_compositor>;
+using gl_context = handle<swl_gl_context_t, swl_destroy_gl_context>;
+
+inline compositor create_compositor(const window& w, uint32_t threads) noexcept {
+	return compositor(swl_create_compositor(w.get(), threads));
+}
+
+inline gl_context create_gl_context(const window& w, const swl_gl_desc_t* desc) noexcept {
+	return gl_context(swl_create_gl_context(w.get(), desc));
+}
+
+inline bool compositor_damage(swl_compositor_t* c, std::span<const swl_rect_t> rects) noexcept {
+	return swl_compositor_damage(c, rects.data(), static_cast<uint32_t>(rects.size()));
+}
+
+inline bool get_events(std::span<swl_event_t> events, uint32_t& count) noexcept {
+	return swl_get_events(events.data(), static_cast<uint32_t>(events.size()), &count);
+}
+
+/*
+ * Drains the event queue in batches of N into a buffer inside the range.
+ * Iteration ends once swl_get_events comes back empty; check ok() afterwards
+ * to tell that apart from a failure.
+ *
+ * Events already taken from the queue belong to the range. Breaking out of a
+ * loop leaves the current event and the rest of its batch there, and the next
+ * loop over the same range starts from that event. They are lost if the range
+ * is destroyed first, so declare one range outside the main loop and iterate
+ * it every frame rather than a temporary from events().
+ */
+template <std::size_t N = 64>
+class event_range {
+public:
+	class iterator {
+	public:
+		using value_type = swl_event_t;
+		using difference_type = std::ptrdiff_t;
+
+		iterator() noexcept = default;
+		explicit iterator(event_range* range) noexcept : range_(range) {}
+
+		const swl_event_t& operator*() const noexcept { return range_->buffer_[range_->index_]; }
+		const swl_event_t* operator->() const noexcept { return &range_->buffer_[range_->index_]; }
+		iterator& operator++() noexcept {
+			range_->advance();
+			return *this;
+		}
+		void operator++(int) noexcept { range_->advance(); }
+		bool operator==(std::default_sentinel_t) const noexcept { return range_ == nullptr || range_->count_ == 0; }
+
+	private:
+		event_range* range_ = nullptr;
+	};
+
+	iterator begin() noexcept {
+		if (index_ >= count_) fill();
+		return iterator(this);
+	}
+	std::default_sentinel_t end() const noexcept { return {}; }
+	bool ok() const noexcept { return ok_; }
+
+private:
+	void fill() noexcept {
+		index_ = 0;
+		if (swl_get_events(buffer_.data(), N, &count_) == false) {
+			count_ = 0;
+			ok_ = false;
+		}
+	}
+
+	void advance() noexcept {
+		if (++index_ == count_) fill();
+	}
+
+	std::array<swl_event_t, N> buffer_;
+	uint32_t count_ = 0;
+	uint32_t index_ = 0;
+	bool ok_ = true;
+};
+
+/* only for loops that never break, see event_range */
+template <std::size_t N = 64>
+event_range<N> events() noexcept {
+	return {};
+}
+
+/* typed views of swl_event_t for visit */
+struct quit {};
+
+template <swl_event_type_t T>
+struct key_event {
+	uint32_t keycode;
+	uint32_t scancode;
+	bool repeat;
+};
+
+struct mouse_move {
+	uint32_t x;
+	uint32_t y;
+	uint32_t oldx;
+	uint32_t oldy;
+};
+
+template <swl_event_type_t T>
+struct button_event {
+	uint32_t button;
+};
+
+template <swl_event_type_t T>
+struct resize_event {
+	uint32_t w;
+	uint32_t h;
+	uint32_t oldw;
+	uint32_t oldh;
+};
+
+using key_down = key_event<SWL_EVENT_KEYDOWN>;
+using key_up = key_event<SWL_EVENT_KEYUP>;
+using mouse_down = button_event<SWL_EVENT_MOUSEDOWN>;
+using mouse_up = button_event<SWL_EVENT_MOUSEUP>;
+using resizing = resize_event<SWL_EVENT_RESIZING>;
+using resized = resize_event<SWL_EVENT_RESIZED>;
+using paint = swl_rect_t;
+
+template <class... Fs>
+struct overload : Fs... {
+	using Fs::operator()...;
+};
+
+template <class... Fs>
+overload(Fs...) -> overload<Fs...>;
+
+namespace detail {
+
+template <class F, class E>
+constexpr void call(F& f, const E& e) {
+	if constexpr (std::is_invocable_v<F&, const E&>) f(e);
+}
+
+} // namespace detail
+
+/*
+ * Calls f with the typed view of e. Event types f has no overload for are
+ * skipped, so pass a generic lambda to catch the rest. The switch is over a
+ * dense enum, so it compiles to a jump table like a hand-written one.
+ */
+template <class F>
+constexpr void visit(const swl_event_t& e, F&& f) {
+	switch (e.type) {
+	case SWL_EVENT_NONE: break;
+	case SWL_EVENT_QUIT: detail::call(f, quit{}); break;
+	case SWL_EVENT_KEYDOWN: detail::call(f, key_down{ e.key.keycode, e.key.scancode, e.key.repeat }); break;
+	case SWL_EVENT_KEYUP: detail::call(f, key_up{ e.key.keycode, e.key.scancode, e.key.repeat }); break;
+	case SWL_EVENT_MOUSEMOVE: detail::call(f, mouse_move{ e.mouse_move.x, e.mouse_move.y, e.mouse_move.oldx, e.mouse_move.oldy }); break;
+	case SWL_EVENT_MOUSEDOWN: detail::call(f, mouse_down{ e.mouse_button.button }); break;
+	case SWL_EVENT_MOUSEUP: detail::call(f, mouse_up{ e.mouse_button.button }); break;
+	case SWL_EVENT_RESIZING: detail::call(f, resizing{ e.resize.w, e.resize.h, e.resize.oldw, e.resize.oldh }); break;
+	case SWL_EVENT_RESIZED: detail::call(f, resized{ e.resize.w, e.resize.h, e.resize.oldw, e.resize.oldh }); break;
+	case SWL_EVENT_PAINT: detail::call(f, paint{ e.paint.x0, e.paint.y0, e.paint.x1, e.paint.y1 }); break;
+	}
+}
+
+} // namespace swl
+
+#endif /* !_SWL_HPP_ */
@@ -0,0 +1,108 @@
+#include <swl.h>
+
+/*
+ * MODULE SUMMARY
+ *
+ * memory.c - provides memory configuration, accounting and trimming.
+ *
+ * Every long-lived arena and pool is registered here with the subsystem that
+ * owns it, so that their usage can be reported and their unused tail pages
+ * decommitted in one place. Like pool.c, this file should be kept platform
+ * independent, and only rely on arenas.
+ *
+ * Owners embed a swl_tracked_t and link it into a list, so there is no limit
+ * on how much can be tracked. Memory allocated outside of arenas, like GDI
+ * bitmaps, is reported through the node's external byte count, and the node's
+ * trim callback lets its owner free caches on swl_trim_memory.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+swl_memory_config_t swl_memory_config = {
+	.arena_reserve = 32 * 1024 * 1024,
+	.arena_commit = 32 * 1024,
+};
+
+static swl_tracked_t* tracked = NULL;
+
+bool swl_set_memory_config(const swl_memory_config_t* config) {
+	if (config == NULL) return swl_error("Parameter must not be NULL.");
+	if (config->arena_commit == 0) return swl_error("Commit size must not be 0.");
+	if (config->arena_reserve < config->arena_commit)
+		return swl_error("Reserve size must not be smaller than commit size.");
+
+	swl_memory_config = *config;
+	return true;
+}
+
+void swl_untrack(swl_tracked_t* node) {
+	for (swl_tracked_t** p = &tracked; *p != NULL; p = &(*p)->next) {
+		if (*p != node) continue;
+		*p = node->next;
+		node->next = NULL;
+		return;
+	}
+}
+
+static void track(swl_tracked_t* node, swl_arena_t* arena, swl_pool_t* pool, swl_memory_subsystem_t subsystem) {
+	/* tracking twice would make the list loop */
+	swl_untrack(node);
+	node->arena = arena;
+	node->pool = pool;
+	node->subsystem = subsystem;
+	node->external = 0;
+	node->trim = NULL;
+	node->user = NULL;
+	node->next = tracked;
+	tracked = node;
+}
+
+void swl_track_arena(swl_tracked_t* node, swl_arena_t* arena, swl_memory_subsystem_t subsystem) {
+	track(node, arena, NULL, subsystem);
+}
+
+void swl_track_pool(swl_tracked_t* node, swl_pool_t* pool, swl_memory_subsystem_t subsystem) {
+	track(node, &pool->arena, pool, subsystem);
+}
+
+bool swl_trim_memory(void) {
+	for (swl_tracked_t* node = tracked; node != NULL; node = node->next) {
+		if (node->trim) node->trim(node->user);
+		if (node->pool) swl_trim_pool(node->pool);
+		else swl_trim_arena(node->arena);
+	}
+	return true;
+}
+
+bool swl_get_memory_stats(swl_memory_stats_t* stats) {
+	if (stats == NULL) return swl_error("Parameter must not be NULL.");
+
+	for (int i = 0; i < SWL_MEMORY_COUNT; i++) {
+		stats->subsystem[i].reserved = 0;
+		stats->subsystem[i].committed = 0;
+		stats->subsystem[i].live = 0;
+	}
+
+	for (swl_tracked_t* node = tracked; node != NULL; node = node->next) {
+		swl_memory_usage_t* u = &stats->subsystem[node->subsystem];
+		swl_arena_t* arena = node->arena;
+		u->reserved += arena->reserved + node->external;
+		u->committed += arena->committed + node->external;
+		if (node->pool) {
+			u->live += node->pool->live * node->pool->size + node->external;
+		} else {
+			u->live += arena->pos + node->external;
+		}
+	}
+
+	stats->total.reserved = 0;
+	stats->total.committed = 0;
+	stats->total.live = 0;
+	for (int i = 0; i < SWL_MEMORY_COUNT; i++) {
+		stats->total.reserved += stats->subsystem[i].reserved;
+		stats->total.committed += stats->subsystem[i].committed;
+		stats->total.live += stats->subsystem[i].live;
+	}
+	return true;
+}
@@ -9,6 +9,10 @@
  * queue (since stacks don't work well with FIFO). This file should be kept
  * platform independent, and only rely on arenas.
  *
+ * Free chunks hold the free list, so their pages cannot be decommitted while
+ * other chunks are live. swl_trim_pool only gives memory back once the whole
+ * pool is free, by starting it over.
+ *
  * AUTHOR: Finxx
  * DATE: 2025.05.10
  */
@@ -26,6 +30,7 @@ swl_pool_t swl_new_pool(ptrdiff_t size) {
 
 	if (size < sizeof(void*)) return zero;
 
+	pool.size = size;
 	pool.arena = swl_new_arena();
 	if (pool.arena.base == NULL) return zero;
 	pool.free_list = swl_push_arena(&pool.arena, POOL_SIZE * size);
@@ -65,6 +70,7 @@ void* swl_pool_alloc(swl_pool_t* pool) {
 	chunk* r = pool->free_list;
 	pool->free_list = r->next_chunk;
 	r->next_chunk = NULL;
+	pool->live++;
 	return r;
 }
 
@@ -75,10 +81,21 @@ void swl_pool_free(swl_pool_t* pool, void* ptr) {
 	chunk* r = ptr;
 	r->next_chunk = pool->free_list;
 	pool->free_list = r;
+	pool->live--;
 }
 
 void swl_free_pool(swl_pool_t* pool) {
 	swl_free_arena(&pool->arena);
 	pool->free_list = NULL;
+	pool->live = 0;
 }
 
+void swl_trim_pool(swl_pool_t* pool) {
+	if (pool == NULL) return;
+
+	if (pool->live == 0) {
+		swl_clear_arena(&pool->arena);
+		pool->free_list = NULL;
+	}
+	swl_trim_arena(&pool->arena);
+}
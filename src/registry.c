@@ -9,6 +9,10 @@
  * When a backend is selected, a vtable is built, and calling platform-specific
  * functions forwards to the function in that vtable.
  *
+ * On Unix, SWL_BACKEND_ANY picks the backend from the environment: Wayland if
+ * WAYLAND_DISPLAY is set, then X11 if DISPLAY is set. Backends load their
+ * client libraries themselves, so only the chosen one pays for it.
+ *
  * AUTHOR: Finxx
  * DATE: 2025.05.09
  */
@@ -26,8 +30,29 @@ const char* swl_get_error(void) {
 
 static swl_backend_t swl_current_backend = SWL_BACKEND_ANY;
 
+#ifdef SWL_UNIX
+#include <stdlib.h>
+
+static bool env_set(const char* name) {
+	const char* value = getenv(name);
+	return value != NULL && value[0] != '\0';
+}
+
+static bool swl_init_any(void) {
+	bool wayland = env_set("WAYLAND_DISPLAY");
+	bool x11 = env_set("DISPLAY");
+	if (wayland == false && x11 == false) return swl_error("No display server found.");
+
+	/* on failure, the error set by the last backend tried is kept */
+	if (wayland && swl_init(SWL_BACKEND_WAYLAND)) return true;
+	if (x11 && swl_init(SWL_BACKEND_X11)) return true;
+	return false;
+}
+#endif
+
 static struct {
 	swl_window_t* (*swl_create_window)(void);
+	bool (*swl_destroy_window)(swl_window_t* window);
 	bool (*swl_set_window_title)(swl_window_t* window, const char* title);
 	bool (*swl_set_window_size)(swl_window_t* window, uint32_t x, uint32_t y);
 	bool (*swl_set_window_pos)(swl_window_t* window, uint32_t x, uint32_t y);
@@ -44,7 +69,28 @@ static struct {
 	bool (*swl_get_window_visible)(swl_window_t* window, bool* visible);
 	void* (*swl_get_window_handle_raw)(swl_window_t* window);
 	bool (*swl_get_event)(swl_event_t* event);
+	bool (*swl_get_events)(swl_event_t* events, uint32_t max, uint32_t* count);
 	bool (*swl_wait_event)(void);
+	bool (*swl_dispatch_pending)(void);
+	int (*swl_get_poll_fd)(void);
+	bool (*swl_set_event_mask)(swl_window_t* window, uint32_t mask);
+	bool (*swl_get_event_mask)(swl_window_t* window, uint32_t* mask);
+	bool (*swl_get_event_stats)(swl_event_stats_t* stats);
+	swl_gl_context_t* (*swl_create_gl_context)(swl_window_t* window, const swl_gl_desc_t* desc);
+	bool (*swl_destroy_gl_context)(swl_gl_context_t* context);
+	bool (*swl_make_current)(swl_gl_context_t* context);
+	bool (*swl_swap_buffers)(swl_gl_context_t* context);
+	bool (*swl_set_swap_interval)(swl_gl_context_t* context, int interval);
+	uint64_t (*swl_get_time)(void);
+	bool (*swl_frame_begin)(swl_window_t* window, swl_frame_t* frame);
+	bool (*swl_frame_end)(swl_window_t* window, bool* on_time);
+	bool (*swl_get_frame_stats)(swl_window_t* window, swl_frame_stats_t* stats);
+	swl_compositor_t* (*swl_create_compositor)(swl_window_t* window, uint32_t threads);
+	bool (*swl_destroy_compositor)(swl_compositor_t* compositor);
+	bool (*swl_compositor_damage)(swl_compositor_t* compositor, const swl_rect_t* rects, uint32_t count);
+	bool (*swl_compositor_render)(swl_compositor_t* compositor, swl_tile_fn_t fn, void* user);
+	bool (*swl_set_window_live_resize)(swl_window_t* window, swl_live_resize_t mode);
+	bool (*swl_get_window_live_resize)(swl_window_t* window, swl_live_resize_t* mode);
 	const char* (*swl_get_error)(void);
 } swl_vtable;
 
@@ -59,7 +105,7 @@ bool swl_init(swl_backend_t backend) {
 	if (backend == SWL_BACKEND_ANY) backend = SWL_BACKEND_COCOA;
 	if (backend != SWL_BACKEND_COCOA)
 #elif defined(SWL_UNIX)
-	if (backend == SWL_BACKEND_ANY) backend = SWL_BACKEND_X11;
+	if (backend == SWL_BACKEND_ANY) return swl_init_any();
 	if (backend != SWL_BACKEND_X11 && backend != SWL_BACKEND_WAYLAND)
 #else
 #error unimplemented
@@ -72,6 +118,7 @@ bool swl_init(swl_backend_t backend) {
 
 #ifdef SWL_WINDOWS
 	ADD_TO_VTABLE(swl_create_window, w32);
+	ADD_TO_VTABLE(swl_destroy_window, w32);
 	ADD_TO_VTABLE(swl_set_window_title, w32);
 	ADD_TO_VTABLE(swl_set_window_size, w32);
 	ADD_TO_VTABLE(swl_set_window_pos, w32);
@@ -88,10 +135,32 @@ bool swl_init(swl_backend_t backend) {
 	ADD_TO_VTABLE(swl_get_window_visible, w32);
 	ADD_TO_VTABLE(swl_get_window_handle_raw, w32);
 	ADD_TO_VTABLE(swl_get_event, w32);
+	ADD_TO_VTABLE(swl_get_events, w32);
 	ADD_TO_VTABLE(swl_wait_event, w32);
+	ADD_TO_VTABLE(swl_dispatch_pending, w32);
+	ADD_TO_VTABLE(swl_get_poll_fd, w32);
+	ADD_TO_VTABLE(swl_set_event_mask, w32);
+	ADD_TO_VTABLE(swl_get_event_mask, w32);
+	ADD_TO_VTABLE(swl_get_event_stats, w32);
+	ADD_TO_VTABLE(swl_create_gl_context, w32);
+	ADD_TO_VTABLE(swl_destroy_gl_context, w32);
+	ADD_TO_VTABLE(swl_make_current, w32);
+	ADD_TO_VTABLE(swl_swap_buffers, w32);
+	ADD_TO_VTABLE(swl_set_swap_interval, w32);
+	ADD_TO_VTABLE(swl_get_time, w32);
+	ADD_TO_VTABLE(swl_frame_begin, w32);
+	ADD_TO_VTABLE(swl_frame_end, w32);
+	ADD_TO_VTABLE(swl_get_frame_stats, w32);
+	ADD_TO_VTABLE(swl_create_compositor, w32);
+	ADD_TO_VTABLE(swl_destroy_compositor, w32);
+	ADD_TO_VTABLE(swl_compositor_damage, w32);
+	ADD_TO_VTABLE(swl_compositor_render, w32);
+	ADD_TO_VTABLE(swl_set_window_live_resize, w32);
+	ADD_TO_VTABLE(swl_get_window_live_resize, w32);
 	return w32_swl_init();
 #elif defined(SWL_MACOS)
 	ADD_TO_VTABLE(swl_create_window, cocoa);
+	ADD_TO_VTABLE(swl_destroy_window, cocoa);
 	ADD_TO_VTABLE(swl_set_window_title, cocoa);
 	ADD_TO_VTABLE(swl_set_window_size, cocoa);
 	ADD_TO_VTABLE(swl_set_window_pos, cocoa);
@@ -108,11 +177,33 @@ bool swl_init(swl_backend_t backend) {
 	ADD_TO_VTABLE(swl_get_window_visible, cocoa);
 	ADD_TO_VTABLE(swl_get_window_handle_raw, cocoa);
 	ADD_TO_VTABLE(swl_get_event, cocoa);
+	ADD_TO_VTABLE(swl_get_events, cocoa);
 	ADD_TO_VTABLE(swl_wait_event, cocoa);
+	ADD_TO_VTABLE(swl_dispatch_pending, cocoa);
+	ADD_TO_VTABLE(swl_get_poll_fd, cocoa);
+	ADD_TO_VTABLE(swl_set_event_mask, cocoa);
+	ADD_TO_VTABLE(swl_get_event_mask, cocoa);
+	ADD_TO_VTABLE(swl_get_event_stats, cocoa);
+	ADD_TO_VTABLE(swl_create_gl_context, cocoa);
+	ADD_TO_VTABLE(swl_destroy_gl_context, cocoa);
+	ADD_TO_VTABLE(swl_make_current, cocoa);
+	ADD_TO_VTABLE(swl_swap_buffers, cocoa);
+	ADD_TO_VTABLE(swl_set_swap_interval, cocoa);
+	ADD_TO_VTABLE(swl_get_time, cocoa);
+	ADD_TO_VTABLE(swl_frame_begin, cocoa);
+	ADD_TO_VTABLE(swl_frame_end, cocoa);
+	ADD_TO_VTABLE(swl_get_frame_stats, cocoa);
+	ADD_TO_VTABLE(swl_create_compositor, cocoa);
+	ADD_TO_VTABLE(swl_destroy_compositor, cocoa);
+	ADD_TO_VTABLE(swl_compositor_damage, cocoa);
+	ADD_TO_VTABLE(swl_compositor_render, cocoa);
+	ADD_TO_VTABLE(swl_set_window_live_resize, cocoa);
+	ADD_TO_VTABLE(swl_get_window_live_resize, cocoa);
 	return cocoa_swl_init();
 #elif defined(SWL_UNIX)
 	if (backend == SWL_BACKEND_X11) {
 		ADD_TO_VTABLE(swl_create_window, x11);
+		ADD_TO_VTABLE(swl_destroy_window, x11);
 		ADD_TO_VTABLE(swl_set_window_title, x11);
 		ADD_TO_VTABLE(swl_set_window_size, x11);
 		ADD_TO_VTABLE(swl_set_window_pos, x11);
@@ -129,10 +220,32 @@ bool swl_init(swl_backend_t backend) {
 		ADD_TO_VTABLE(swl_get_window_visible, x11);
 		ADD_TO_VTABLE(swl_get_window_handle_raw, x11);
 		ADD_TO_VTABLE(swl_get_event, x11);
+		ADD_TO_VTABLE(swl_get_events, x11);
 		ADD_TO_VTABLE(swl_wait_event, x11);
+		ADD_TO_VTABLE(swl_dispatch_pending, x11);
+		ADD_TO_VTABLE(swl_get_poll_fd, x11);
+		ADD_TO_VTABLE(swl_set_event_mask, x11);
+		ADD_TO_VTABLE(swl_get_event_mask, x11);
+		ADD_TO_VTABLE(swl_get_event_stats, x11);
+		ADD_TO_VTABLE(swl_create_gl_context, x11);
+		ADD_TO_VTABLE(swl_destroy_gl_context, x11);
+		ADD_TO_VTABLE(swl_make_current, x11);
+		ADD_TO_VTABLE(swl_swap_buffers, x11);
+		ADD_TO_VTABLE(swl_set_swap_interval, x11);
+		ADD_TO_VTABLE(swl_get_time, x11);
+		ADD_TO_VTABLE(swl_frame_begin, x11);
+		ADD_TO_VTABLE(swl_frame_end, x11);
+		ADD_TO_VTABLE(swl_get_frame_stats, x11);
+		ADD_TO_VTABLE(swl_create_compositor, x11);
+		ADD_TO_VTABLE(swl_destroy_compositor, x11);
+		ADD_TO_VTABLE(swl_compositor_damage, x11);
+		ADD_TO_VTABLE(swl_compositor_render, x11);
+		ADD_TO_VTABLE(swl_set_window_live_resize, x11);
+		ADD_TO_VTABLE(swl_get_window_live_resize, x11);
 		return x11_swl_init();
 	} else {
 		ADD_TO_VTABLE(swl_create_window, wl);
+		ADD_TO_VTABLE(swl_destroy_window, wl);
 		ADD_TO_VTABLE(swl_set_window_title, wl);
 		ADD_TO_VTABLE(swl_set_window_size, wl);
 		ADD_TO_VTABLE(swl_set_window_pos, wl);
@@ -149,16 +262,45 @@ bool swl_init(swl_backend_t backend) {
 		ADD_TO_VTABLE(swl_get_window_visible, wl);
 		ADD_TO_VTABLE(swl_get_window_handle_raw, wl);
 		ADD_TO_VTABLE(swl_get_event, wl);
+		ADD_TO_VTABLE(swl_get_events, wl);
 		ADD_TO_VTABLE(swl_wait_event, wl);
+		ADD_TO_VTABLE(swl_dispatch_pending, wl);
+		ADD_TO_VTABLE(swl_get_poll_fd, wl);
+		ADD_TO_VTABLE(swl_set_event_mask, wl);
+		ADD_TO_VTABLE(swl_get_event_mask, wl);
+		ADD_TO_VTABLE(swl_get_event_stats, wl);
+		ADD_TO_VTABLE(swl_create_gl_context, wl);
+		ADD_TO_VTABLE(swl_destroy_gl_context, wl);
+		ADD_TO_VTABLE(swl_make_current, wl);
+		ADD_TO_VTABLE(swl_swap_buffers, wl);
+		ADD_TO_VTABLE(swl_set_swap_interval, wl);
+		ADD_TO_VTABLE(swl_get_time, wl);
+		ADD_TO_VTABLE(swl_frame_begin, wl);
+		ADD_TO_VTABLE(swl_frame_end, wl);
+		ADD_TO_VTABLE(swl_get_frame_stats, wl);
+		ADD_TO_VTABLE(swl_create_compositor, wl);
+		ADD_TO_VTABLE(swl_destroy_compositor, wl);
+		ADD_TO_VTABLE(swl_compositor_damage, wl);
+		ADD_TO_VTABLE(swl_compositor_render, wl);
+		ADD_TO_VTABLE(swl_set_window_live_resize, wl);
+		ADD_TO_VTABLE(swl_get_window_live_resize, wl);
 		return wl_swl_init();
 	}
 #endif
 }
 
+swl_backend_t swl_get_backend(void) {
+	return swl_current_backend;
+}
+
 swl_window_t* swl_create_window(void) {
 	return swl_vtable.swl_create_window();
 }
 
+bool swl_destroy_window(swl_window_t* window) {
+	return swl_vtable.swl_destroy_window(window);
+}
+
 bool swl_set_window_title(swl_window_t* window, const char* title) {
 	return swl_vtable.swl_set_window_title(window, title);
 }
@@ -223,6 +365,90 @@ bool swl_get_event(swl_event_t* event) {
 	return swl_vtable.swl_get_event(event);
 }
 
+bool swl_get_events(swl_event_t* events, uint32_t max, uint32_t* count) {
+	return swl_vtable.swl_get_events(events, max, count);
+}
+
 bool swl_wait_event(void) {
 	return swl_vtable.swl_wait_event();
 }
+
+bool swl_dispatch_pending(void) {
+	return swl_vtable.swl_dispatch_pending();
+}
+
+int swl_get_poll_fd(void) {
+	return swl_vtable.swl_get_poll_fd();
+}
+
+bool swl_set_event_mask(swl_window_t* window, uint32_t mask) {
+	return swl_vtable.swl_set_event_mask(window, mask);
+}
+
+bool swl_get_event_mask(swl_window_t* window, uint32_t* mask) {
+	return swl_vtable.swl_get_event_mask(window, mask);
+}
+
+bool swl_get_event_stats(swl_event_stats_t* stats) {
+	return swl_vtable.swl_get_event_stats(stats);
+}
+
+swl_gl_context_t* swl_create_gl_context(swl_window_t* window, const swl_gl_desc_t* desc) {
+	return swl_vtable.swl_create_gl_context(window, desc);
+}
+
+bool swl_destroy_gl_context(swl_gl_context_t* context) {
+	return swl_vtable.swl_destroy_gl_context(context);
+}
+
+bool swl_make_current(swl_gl_context_t* context) {
+	return swl_vtable.swl_make_current(context);
+}
+
+bool swl_swap_buffers(swl_gl_context_t* context) {
+	return swl_vtable.swl_swap_buffers(context);
+}
+
+bool swl_set_swap_interval(swl_gl_context_t* context, int interval) {
+	return swl_vtable.swl_set_swap_interval(context, interval);
+}
+
+uint64_t swl_get_time(void) {
+	return swl_vtable.swl_get_time();
+}
+
+bool swl_frame_begin(swl_window_t* window, swl_frame_t* frame) {
+	return swl_vtable.swl_frame_begin(window, frame);
+}
+
+bool swl_frame_end(swl_window_t* window, bool* on_time) {
+	return swl_vtable.swl_frame_end(window, on_time);
+}
+
+bool swl_get_frame_stats(swl_window_t* window, swl_frame_stats_t* stats) {
+	return swl_vtable.swl_get_frame_stats(window, stats);
+}
+
+swl_compositor_t* swl_create_compositor(swl_window_t* window, uint32_t threads) {
+	return swl_vtable.swl_create_compositor(window, threads);
+}
+
+bool swl_destroy_compositor(swl_compositor_t* compositor) {
+	return swl_vtable.swl_destroy_compositor(compositor);
+}
+
+bool swl_compositor_damage(swl_compositor_t* compositor, const swl_rect_t* rects, uint32_t count) {
+	return swl_vtable.swl_compositor_damage(compositor, rects, count);
+}
+
+bool swl_compositor_render(swl_compositor_t* compositor, swl_tile_fn_t fn, void* user) {
+	return swl_vtable.swl_compositor_render(compositor, fn, user);
+}
+
+bool swl_set_window_live_resize(swl_window_t* window, swl_live_resize_t mode) {
+	return swl_vtable.swl_set_window_live_resize(window, mode);
+}
+
+bool swl_get_window_live_resize(swl_window_t* window, swl_live_resize_t* mode) {
+	return swl_vtable.swl_get_window_live_resize(window, mode);
+}
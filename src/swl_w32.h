@@ -3,17 +3,132 @@
 #ifdef _WIN32
 
 #include <Windows.h>
+#include <dwmapi.h>
 #include <stdbool.h>
 
+#include <swl.h>
+
 struct swl_window_t {
 	HWND hWnd;
 	bool transparent;
+	bool sizing;
+	uint32_t width;
+	uint32_t height;
+	/* size when the size-move loop started */
+	uint32_t enter_width;
+	uint32_t enter_height;
+	uint32_t mouse_x;
+	uint32_t mouse_y;
+	uint32_t event_mask;
+	swl_live_resize_t live_resize;
+	swl_compositor_t* compositor;
+	struct {
+		uint64_t begin;
+		uint64_t submit;
+		uint64_t compose;
+		uint64_t present;
+		uint64_t lag;
+		uint64_t lag_low;
+		uint64_t lag_samples;
+		uint64_t period;
+		uint64_t anchor;
+		uint64_t render;
+		uint64_t frames;
+		uint64_t missed;
+		uint64_t confirmed;
+		uint64_t latency_total;
+		uint64_t latency_max;
+	} frame;
 };
 
-#include <swl.h>
+struct swl_gl_context_t {
+	swl_window_t* window;
+	HDC hDC;
+	HGLRC hGLRC;
+};
+
+#define W32_MAX_THREADS 64
+
+#ifdef _MSC_VER
+#define W32_CACHE_ALIGNED __declspec(align(64))
+#else
+#define W32_CACHE_ALIGNED __attribute__((aligned(64)))
+#endif
+
+/*
+ * Aligned, so each worker's counters sit on their own cache line. This holds
+ * inside swl_compositor_t because compositors start at a page-aligned arena.
+ */
+typedef struct W32_CACHE_ALIGNED {
+	volatile LONG next;
+	LONG end;
+	swl_compositor_t* compositor;
+	uint32_t index;
+} w32_tile_worker_t;
+
+struct swl_compositor_t {
+	swl_arena_t arena;
+	swl_tracked_t tracked;
+	ptrdiff_t arena_base;
+	swl_window_t* window;
+	HDC hMemDC;
+	HBITMAP hBitmap;
+	HGDIOBJ old_bitmap;
+	uint32_t* pixels;
+	uint32_t width;
+	uint32_t height;
+	uint32_t tiles_x;
+	uint32_t tiles_y;
+	uint8_t* dirty;
+	uint32_t* work;
+	uint32_t work_count;
+	bool presented;
+	HBITMAP last_bitmap;
+	uint32_t* last_pixels;
+	uint32_t last_width;
+	uint32_t last_height;
+	uint32_t* scale;
+	ptrdiff_t scale_capacity;
+	swl_tile_fn_t fn;
+	void* user;
+	uint32_t threads;
+	HANDLE thread[W32_MAX_THREADS];
+	HANDLE start;
+	HANDLE done;
+	volatile LONG pending;
+	volatile LONG quit;
+	w32_tile_worker_t worker[W32_MAX_THREADS];
+};
+
+/* optional libraries, loaded on first use by win32_load.c */
+typedef struct {
+	HMODULE module;
+	bool loaded;
+	bool failed;
+	HRESULT (WINAPI *DwmEnableBlurBehindWindow)(HWND hWnd, const DWM_BLURBEHIND* pBlurBehind);
+	HRESULT (WINAPI *DwmGetCompositionTimingInfo)(HWND hwnd, DWM_TIMING_INFO* pTimingInfo);
+} w32_dwm_t;
+
+typedef struct {
+	HMODULE module;
+	bool loaded;
+	bool failed;
+	HGLRC (WINAPI *wglCreateContext)(HDC hDC);
+	BOOL (WINAPI *wglDeleteContext)(HGLRC hGLRC);
+	BOOL (WINAPI *wglMakeCurrent)(HDC hDC, HGLRC hGLRC);
+	HGLRC (WINAPI *wglGetCurrentContext)(void);
+	PROC (WINAPI *wglGetProcAddress)(LPCSTR name);
+} w32_wgl_t;
+
+extern w32_dwm_t w32_dwm;
+extern w32_wgl_t w32_wgl;
+
+bool w32_load_dwm(void);
+bool w32_load_wgl(void);
 
 bool w32_swl_init(void);
 swl_window_t* w32_swl_create_window(void);
+bool w32_swl_destroy_window(swl_window_t* window);
 bool w32_swl_set_window_title(swl_window_t* window, const char* title);
 bool w32_swl_set_window_size(swl_window_t* window, uint32_t x, uint32_t y);
 bool w32_swl_set_window_pos(swl_window_t* window, uint32_t x, uint32_t y);
@@ -32,7 +147,36 @@ void* w32_swl_get_window_handle_raw(swl_window_t* window);
 
 bool w32_swl_events_init(void);
 bool w32_swl_get_event(swl_event_t* event);
+bool w32_swl_get_events(swl_event_t* events, uint32_t max, uint32_t* count);
 bool w32_swl_wait_event(void);
+bool w32_swl_dispatch_pending(void);
+int w32_swl_get_poll_fd(void);
+bool w32_swl_set_event_mask(swl_window_t* window, uint32_t mask);
+bool w32_swl_get_event_mask(swl_window_t* window, uint32_t* mask);
+bool w32_swl_get_event_stats(swl_event_stats_t* stats);
+
+swl_gl_context_t* w32_swl_create_gl_context(swl_window_t* window, const swl_gl_desc_t* desc);
+bool w32_swl_destroy_gl_context(swl_gl_context_t* context);
+bool w32_swl_make_current(swl_gl_context_t* context);
+bool w32_swl_swap_buffers(swl_gl_context_t* context);
+bool w32_swl_set_swap_interval(swl_gl_context_t* context, int interval);
+
+void w32_swl_frame_init(swl_window_t* window);
+uint64_t w32_swl_get_time(void);
+bool w32_swl_frame_begin(swl_window_t* window, swl_frame_t* frame);
+bool w32_swl_frame_end(swl_window_t* window, bool* on_time);
+void w32_swl_frame_submit(swl_window_t* window);
+bool w32_swl_get_frame_stats(swl_window_t* window, swl_frame_stats_t* stats);
+
+swl_compositor_t* w32_swl_create_compositor(swl_window_t* window, uint32_t threads);
+bool w32_swl_destroy_compositor(swl_compositor_t* compositor);
+bool w32_swl_compositor_damage(swl_compositor_t* compositor, const swl_rect_t* rects, uint32_t count);
+bool w32_swl_compositor_render(swl_compositor_t* compositor, swl_tile_fn_t fn, void* user);
+
+bool w32_swl_set_window_live_resize(swl_window_t* window, swl_live_resize_t mode);
+bool w32_swl_get_window_live_resize(swl_window_t* window, swl_live_resize_t* mode);
+bool w32_swl_live_resize_ready(swl_window_t* window);
+bool w32_swl_live_resize_paint(swl_window_t* window, HDC hDC);
 
 #endif /* _WIN32 */
 #endif /* !_SWL_W32_H_ */
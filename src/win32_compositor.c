@@ -0,0 +1,358 @@
+#include "swl_w32.h"
+
+#ifdef SWL_WINDOWS
+
+/*
+ * MODULE SUMMARY
+ *
+ * win32_compositor.c - provides a parallel, damage-driven software compositor.
+ *
+ * The framebuffer is a DIB section split into TILE_SIZE square tiles, small
+ * enough that one tile stays in cache while it is filled. Damage rects mark
+ * tiles dirty, and swl_compositor_render hands each dirty tile to a user
+ * callback on a pool of worker threads, then blits only the dirty tiles to the
+ * window, merging runs of neighbouring tiles into one BitBlt.
+ *
+ * Work distribution: the dirty tile list is split into one contiguous range
+ * per thread. A thread drains its own range first and then steals single tiles
+ * from the others' ranges, all with InterlockedIncrement on the range's next
+ * index, so there are no locks and no tile is drawn twice. The calling thread
+ * is worker 0, so a compositor with 1 thread never starts any threads.
+ *
+ * Each compositor lives at the start of its own arena, which also holds the
+ * tile bookkeeping and is reset whenever the window changes size.
+ *
+ * With live resize enabled on the window, the last presented framebuffer is
+ * kept when the window changes size, so win32_resize.c can keep rescaling it
+ * until a frame at the new size has been rendered. swl_trim_memory frees the
+ * kept framebuffer unless a resize is in progress, and the scaling buffer.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+#define TILE_SIZE 64
+
+/* DIB sections live outside the arena, so they are counted as external */
+static ptrdiff_t dib_bytes(uint32_t w, uint32_t h) {
+	return (ptrdiff_t)w * h * sizeof(uint32_t);
+}
+
+static void drop_last(swl_compositor_t* c) {
+	if (c->last_bitmap == NULL) return;
+	DeleteObject(c->last_bitmap);
+	c->tracked.external -= dib_bytes(c->last_width, c->last_height);
+	c->last_bitmap = NULL;
+	c->last_pixels = NULL;
+	c->last_width = 0;
+	c->last_height = 0;
+}
+
+static void drop_scale(swl_compositor_t* c) {
+	if (c->scale == NULL) return;
+	VirtualFree(c->scale, 0, MEM_RELEASE);
+	c->tracked.external -= c->scale_capacity;
+	c->scale = NULL;
+	c->scale_capacity = 0;
+}
+
+/* swl_trim_memory: both are only needed while the user is dragging */
+static void trim_compositor(void* user) {
+	swl_compositor_t* c = user;
+	drop_scale(c);
+	if (c->window->sizing == false) drop_last(c);
+}
+
+static bool ensure_size(swl_compositor_t* c) {
+	RECT rc;
+	if (GetClientRect(c->window->hWnd, &rc) == 0) return swl_error("GetClientRect failed.");
+	uint32_t w = rc.right - rc.left;
+	uint32_t h = rc.bottom - rc.top;
+	if (w == c->width && h == c->height && c->hBitmap != NULL) return true;
+
+	if (c->hBitmap) {
+		SelectObject(c->hMemDC, c->old_bitmap);
+		if (c->window->live_resize != SWL_LIVE_RESIZE_OFF && c->presented) {
+			drop_last(c);
+			c->last_bitmap = c->hBitmap;
+			c->last_pixels = c->pixels;
+			c->last_width = c->width;
+			c->last_height = c->height;
+		} else {
+			DeleteObject(c->hBitmap);
+			c->tracked.external -= dib_bytes(c->width, c->height);
+		}
+		c->hBitmap = NULL;
+		c->pixels = NULL;
+	}
+	c->presented = false;
+	c->width = 0;
+	c->height = 0;
+	c->tiles_x = 0;
+	c->tiles_y = 0;
+	c->arena.pos = c->arena_base;
+	if (w == 0 || h == 0) return true;
+
+	BITMAPINFO bmi = {
+		.bmiHeader = {
+			.biSize = sizeof(BITMAPINFOHEADER),
+			.biWidth = w,
+			/* negative height means top-down rows */
+			.biHeight = -(LONG)h,
+			.biPlanes = 1,
+			.biBitCount = 32,
+			.biCompression = BI_RGB,
+		},
+	};
+	void* bits = NULL;
+	c->hBitmap = CreateDIBSection(c->hMemDC, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+	if (c->hBitmap == NULL) return swl_error("CreateDIBSection failed.");
+	c->old_bitmap = SelectObject(c->hMemDC, c->hBitmap);
+	c->tracked.external += dib_bytes(w, h);
+
+	uint32_t tiles_x = (w + TILE_SIZE - 1) / TILE_SIZE;
+	uint32_t tiles_y = (h + TILE_SIZE - 1) / TILE_SIZE;
+	uint32_t count = tiles_x * tiles_y;
+	c->dirty = swl_push_arena(&c->arena, count);
+	c->work = swl_push_arena(&c->arena, count * sizeof(uint32_t));
+	if (c->dirty == NULL || c->work == NULL) {
+		SelectObject(c->hMemDC, c->old_bitmap);
+		DeleteObject(c->hBitmap);
+		c->hBitmap = NULL;
+		c->tracked.external -= dib_bytes(w, h);
+		return swl_error("Failed to allocate tiles.");
+	}
+
+	/* everything is stale after a resize */
+	for (uint32_t i = 0; i < count; i++) c->dirty[i] = 1;
+
+	c->pixels = bits;
+	c->width = w;
+	c->height = h;
+	c->tiles_x = tiles_x;
+	c->tiles_y = tiles_y;
+	return true;
+}
+
+static void draw_tile(swl_compositor_t* c, uint32_t tile) {
+	swl_rect_t r;
+	r.x0 = (tile % c->tiles_x) * TILE_SIZE;
+	r.y0 = (tile / c->tiles_x) * TILE_SIZE;
+	r.x1 = r.x0 + TILE_SIZE < c->width ? r.x0 + TILE_SIZE : c->width;
+	r.y1 = r.y0 + TILE_SIZE < c->height ? r.y0 + TILE_SIZE : c->height;
+	c->fn(c->user, c->pixels + (ptrdiff_t)r.y0 * c->width + r.x0, c->width, &r);
+}
+
+static void run_tiles(swl_compositor_t* c, uint32_t self) {
+	/* own range first, then steal from the others in order */
+	for (uint32_t k = 0; k < c->threads; k++) {
+		w32_tile_worker_t* victim = &c->worker[(self + k) % c->threads];
+		for (;;) {
+			LONG i = InterlockedIncrement(&victim->next) - 1;
+			if (i >= victim->end) break;
+			draw_tile(c, c->work[i]);
+		}
+	}
+}
+
+static DWORD WINAPI worker_main(LPVOID param) {
+	w32_tile_worker_t* w = param;
+	swl_compositor_t* c = w->compositor;
+
+	for (;;) {
+		WaitForSingleObject(c->start, INFINITE);
+		if (c->quit) return 0;
+		run_tiles(c, w->index);
+		if (InterlockedDecrement(&c->pending) == 0) SetEvent(c->done);
+	}
+}
+
+static void stop_workers(swl_compositor_t* c) {
+	uint32_t started = 0;
+	for (uint32_t i = 1; i < c->threads; i++)
+		if (c->thread[i]) started++;
+	if (started == 0) return;
+
+	c->quit = 1;
+	ReleaseSemaphore(c->start, started, NULL);
+	for (uint32_t i = 1; i < c->threads; i++) {
+		if (c->thread[i] == NULL) continue;
+		WaitForSingleObject(c->thread[i], INFINITE);
+		CloseHandle(c->thread[i]);
+		c->thread[i] = NULL;
+	}
+}
+
+static void free_compositor(swl_compositor_t* c) {
+	stop_workers(c);
+	if (c->window->compositor == c) c->window->compositor = NULL;
+	drop_last(c);
+	drop_scale(c);
+	if (c->hBitmap) {
+		SelectObject(c->hMemDC, c->old_bitmap);
+		DeleteObject(c->hBitmap);
+	}
+	if (c->hMemDC) DeleteDC(c->hMemDC);
+	if (c->start) CloseHandle(c->start);
+	if (c->done) CloseHandle(c->done);
+	swl_untrack(&c->tracked);
+
+	/* c lives inside its own arena */
+	swl_arena_t arena = c->arena;
+	swl_free_arena(&arena);
+}
+
+swl_compositor_t* w32_swl_create_compositor(swl_window_t* window, uint32_t threads) {
+	if (window == NULL) return (swl_compositor_t*)swl_error("Parameter must not be NULL.");
+
+	if (threads == 0) {
+		SYSTEM_INFO si;
+		GetSystemInfo(&si);
+		threads = si.dwNumberOfProcessors;
+	}
+	if (threads > W32_MAX_THREADS) threads = W32_MAX_THREADS;
+	if (threads == 0) threads = 1;
+
+	swl_arena_t arena = swl_new_arena();
+	if (arena.base == NULL) return (swl_compositor_t*)swl_error("Failed to allocate compositor arena.");
+	swl_compositor_t* c = swl_push_arena(&arena, sizeof(swl_compositor_t));
+	if (c == NULL) {
+		swl_free_arena(&arena);
+		return (swl_compositor_t*)swl_error("Failed to allocate compositor.");
+	}
+	/* fresh arena pages are zeroed, so every other field starts out 0 */
+	c->arena = arena;
+	c->arena_base = arena.pos;
+	c->window = window;
+	c->threads = threads;
+	window->compositor = c;
+	swl_track_arena(&c->tracked, &c->arena, SWL_MEMORY_COMPOSITOR);
+	c->tracked.trim = trim_compositor;
+	c->tracked.user = c;
+
+	c->hMemDC = CreateCompatibleDC(NULL);
+	c->start = CreateSemaphoreW(NULL, 0, threads, NULL);
+	c->done = CreateEventW(NULL, FALSE, FALSE, NULL);
+	if (c->hMemDC == NULL || c->start == NULL || c->done == NULL) {
+		free_compositor(c);
+		return (swl_compositor_t*)swl_error("Failed to create compositor objects.");
+	}
+
+	for (uint32_t i = 0; i < threads; i++) {
+		c->worker[i].compositor = c;
+		c->worker[i].index = i;
+	}
+	for (uint32_t i = 1; i < threads; i++) {
+		c->thread[i] = CreateThread(NULL, 0, worker_main, &c->worker[i], 0, NULL);
+		if (c->thread[i] == NULL) {
+			free_compositor(c);
+			return (swl_compositor_t*)swl_error("CreateThread failed.");
+		}
+	}
+
+	return c;
+}
+
+bool w32_swl_destroy_compositor(swl_compositor_t* compositor) {
+	if (compositor == NULL) return swl_error("Parameter must not be NULL.");
+
+	free_compositor(compositor);
+	return true;
+}
+
+bool w32_swl_compositor_damage(swl_compositor_t* compositor, const swl_rect_t* rects, uint32_t count) {
+	if (compositor == NULL) return swl_error("Parameter must not be NULL.");
+	if (rects == NULL && count != 0) return swl_error("Parameter must not be NULL.");
+	if (ensure_size(compositor) == false) return false;
+
+	swl_compositor_t* c = compositor;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t x1 = rects[i].x1 < c->width ? rects[i].x1 : c->width;
+		uint32_t y1 = rects[i].y1 < c->height ? rects[i].y1 : c->height;
+		if (rects[i].x0 >= x1 || rects[i].y0 >= y1) continue;
+
+		uint32_t tx0 = rects[i].x0 / TILE_SIZE;
+		uint32_t ty0 = rects[i].y0 / TILE_SIZE;
+		uint32_t tx1 = (x1 - 1) / TILE_SIZE;
+		uint32_t ty1 = (y1 - 1) / TILE_SIZE;
+		for (uint32_t ty = ty0; ty <= ty1; ty++)
+			for (uint32_t tx = tx0; tx <= tx1; tx++)
+				c->dirty[ty * c->tiles_x + tx] = 1;
+	}
+	return true;
+}
+
+static void present(swl_compositor_t* c) {
+	HDC hDC = GetDC(c->window->hWnd);
+	if (hDC == NULL) return;
+
+	/* GDI may still be batching writes to the DIB section */
+	GdiFlush();
+
+	uint32_t i = 0;
+	while (i < c->work_count) {
+		uint32_t first = c->work[i];
+		uint32_t last = first;
+		/* merge tiles that are next to each other in the same row */
+		while (i + 1 < c->work_count && c->work[i + 1] == last + 1 && (last + 1) % c->tiles_x != 0) {
+			last++;
+			i++;
+		}
+		i++;
+
+		uint32_t x0 = (first % c->tiles_x) * TILE_SIZE;
+		uint32_t y0 = (first / c->tiles_x) * TILE_SIZE;
+		uint32_t x1 = (last % c->tiles_x) * TILE_SIZE + TILE_SIZE;
+		uint32_t y1 = y0 + TILE_SIZE;
+		if (x1 > c->width) x1 = c->width;
+		if (y1 > c->height) y1 = c->height;
+		BitBlt(hDC, x0, y0, x1 - x0, y1 - y0, c->hMemDC, x0, y0, SRCCOPY);
+	}
+
+	ReleaseDC(c->window->hWnd, hDC);
+}
+
+bool w32_swl_compositor_render(swl_compositor_t* compositor, swl_tile_fn_t fn, void* user) {
+	if (compositor == NULL) return swl_error("Parameter must not be NULL.");
+	if (fn == NULL) return swl_error("Parameter must not be NULL.");
+	if (ensure_size(compositor) == false) return false;
+
+	swl_compositor_t* c = compositor;
+	uint32_t count = c->tiles_x * c->tiles_y;
+	c->work_count = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (c->dirty[i] == 0) continue;
+		c->dirty[i] = 0;
+		c->work[c->work_count++] = i;
+	}
+	if (c->work_count == 0) return true;
+
+	uint32_t per = c->work_count / c->threads;
+	uint32_t extra = c->work_count % c->threads;
+	uint32_t pos = 0;
+	for (uint32_t i = 0; i < c->threads; i++) {
+		uint32_t n = per + (i < extra ? 1 : 0);
+		c->worker[i].next = pos;
+		c->worker[i].end = pos + n;
+		pos += n;
+	}
+
+	c->fn = fn;
+	c->user = user;
+
+	/* no point waking more helpers than there are tiles to share */
+	uint32_t helpers = c->threads - 1;
+	if (helpers > c->work_count - 1) helpers = c->work_count - 1;
+	c->pending = helpers;
+	if (helpers) ReleaseSemaphore(c->start, helpers, NULL);
+	run_tiles(c, 0);
+	if (helpers) WaitForSingleObject(c->done, INFINITE);
+
+	w32_swl_frame_submit(c->window);
+	present(c);
+	drop_last(c);
+	c->presented = true;
+	return true;
+}
+
+#endif /* SWL_WINDOWS */
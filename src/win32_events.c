@@ -11,6 +11,20 @@
  * We maintain our own event queue because one operating system event may
  * translate into multiple SWL events.
  *
+ * Translation happens in wndproc, which is only ever entered from
+ * DispatchMessageW (or directly by Win32 for sent messages), so the queue is
+ * only filled while swl_dispatch_pending or swl_get_event are pumping.
+ *
+ * Each window has an event mask. wndproc works out which swl event a message
+ * would become before doing anything else, and hands masked messages straight
+ * to DefWindowProcW, so they are never translated or queued.
+ *
+ * WM_PAINT always gives win32_resize.c a chance to paint a rescaled frame
+ * first, even if paint events are masked.
+ *
+ * If the event pool cannot grow, the event is lost and counted in the lost
+ * field of swl_get_event_stats; the window keeps working.
+ *
  * AUTHOR: Finxx
  * DATE: 2025.05.21
  */
@@ -21,24 +35,304 @@ typedef struct queue {
 } queue;
 
 static swl_pool_t event_pool;
+static swl_tracked_t event_pool_tracked;
 static queue* oldest_event;
+static queue* newest_event;
+static uint64_t events_queued;
+static uint64_t events_dropped;
+static uint64_t events_lost;
 
 bool w32_swl_events_init(void) {
 	event_pool = swl_new_pool(sizeof(queue));
 	if (event_pool.arena.base == NULL) return swl_error("Failed to allocate event pool.");
+	swl_track_pool(&event_pool_tracked, &event_pool, SWL_MEMORY_EVENTS);
 
 	oldest_event = NULL;
+	newest_event = NULL;
+	events_queued = 0;
+	events_dropped = 0;
+	events_lost = 0;
+
+	return true;
+}
+
+static bool push_event(const swl_event_t* event) {
+	queue* q = swl_pool_alloc(&event_pool);
+	if (q == NULL) {
+		events_lost++;
+		return swl_error("Failed to allocate event.");
+	}
 
+	q->event = *event;
+	q->next = NULL;
+	if (newest_event == NULL) {
+		oldest_event = q;
+	} else {
+		newest_event->next = q;
+	}
+	newest_event = q;
+	events_queued++;
 	return true;
 }
 
+static void push_key(swl_event_type_t type, WPARAM wParam, LPARAM lParam) {
+	swl_event_t e = { .type = type };
+	e.key.keycode = (uint32_t)wParam;
+	e.key.scancode = (uint32_t)((lParam >> 16) & 0x1FF);
+	e.key.repeat = type == SWL_EVENT_KEYDOWN && (lParam & (1 << 30)) != 0;
+	push_event(&e);
+}
+
+static void push_button(swl_event_type_t type, uint32_t button) {
+	swl_event_t e = { .type = type };
+	e.mouse_button.button = button;
+	push_event(&e);
+}
+
+static void push_resize(swl_window_t* window, swl_event_type_t type, uint32_t w, uint32_t h) {
+	swl_event_t e = { .type = type };
+	e.resize.w = w;
+	e.resize.h = h;
+	e.resize.oldw = window->width;
+	e.resize.oldh = window->height;
+	window->width = w;
+	window->height = h;
+	push_event(&e);
+}
+
+/* the swl event uMsg would be translated to, without translating it */
+static swl_event_type_t message_event(swl_window_t* window, UINT uMsg) {
+	switch (uMsg) {
+	case WM_KEYDOWN:
+	case WM_SYSKEYDOWN:
+		return SWL_EVENT_KEYDOWN;
+	case WM_KEYUP:
+	case WM_SYSKEYUP:
+		return SWL_EVENT_KEYUP;
+	case WM_MOUSEMOVE:
+		return SWL_EVENT_MOUSEMOVE;
+	case WM_LBUTTONDOWN:
+	case WM_RBUTTONDOWN:
+	case WM_MBUTTONDOWN:
+	case WM_XBUTTONDOWN:
+		return SWL_EVENT_MOUSEDOWN;
+	case WM_LBUTTONUP:
+	case WM_RBUTTONUP:
+	case WM_MBUTTONUP:
+	case WM_XBUTTONUP:
+		return SWL_EVENT_MOUSEUP;
+	case WM_SIZE:
+		return window->sizing ? SWL_EVENT_RESIZING : SWL_EVENT_RESIZED;
+	case WM_EXITSIZEMOVE:
+		/* moving the window by its title bar goes through the same loop */
+		if (window->width == window->enter_width && window->height == window->enter_height)
+			return SWL_EVENT_NONE;
+		return SWL_EVENT_RESIZED;
+	case WM_PAINT:
+		return SWL_EVENT_PAINT;
+	}
+	return SWL_EVENT_NONE;
+}
+
 LRESULT CALLBACK wndproc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+	if (uMsg == WM_NCCREATE) {
+		CREATESTRUCTW* cs = (CREATESTRUCTW*)lParam;
+		SetWindowLongPtrW(hWnd, GWLP_USERDATA, (LONG_PTR)cs->lpCreateParams);
+		return DefWindowProcW(hWnd, uMsg, wParam, lParam);
+	}
+
+	swl_window_t* window = (swl_window_t*)GetWindowLongPtrW(hWnd, GWLP_USERDATA);
+	if (window == NULL) return DefWindowProcW(hWnd, uMsg, wParam, lParam);
+
+	if (w32_swl_live_resize_ready(window)) {
+		/* the whole frame gets rescaled, so repaint all of it and never erase */
+		if (uMsg == WM_ERASEBKGND) return 1;
+		if (uMsg == WM_SIZE) InvalidateRect(hWnd, NULL, FALSE);
+	}
+
+	swl_event_type_t type = message_event(window, uMsg);
+	if (type != SWL_EVENT_NONE && (window->event_mask & SWL_EVENT_MASK(type)) == 0) {
+		/* minimizing never queues a resize, so there is nothing to drop */
+		if (uMsg != WM_SIZE || wParam != SIZE_MINIMIZED) events_dropped++;
+		/* keep the state unmasked events are computed from */
+		if (uMsg == WM_EXITSIZEMOVE) window->sizing = false;
+		if (uMsg == WM_SIZE && wParam != SIZE_MINIMIZED) {
+			window->width = LOWORD(lParam);
+			window->height = HIWORD(lParam);
+		}
+		if (uMsg == WM_MOUSEMOVE) {
+			window->mouse_x = (uint32_t)(int16_t)LOWORD(lParam);
+			window->mouse_y = (uint32_t)(int16_t)HIWORD(lParam);
+		}
+		if (uMsg == WM_PAINT) {
+			PAINTSTRUCT ps;
+			if (BeginPaint(hWnd, &ps) == NULL) return 0;
+			w32_swl_live_resize_paint(window, ps.hdc);
+			EndPaint(hWnd, &ps);
+			return 0;
+		}
+		return DefWindowProcW(hWnd, uMsg, wParam, lParam);
+	}
+
+	switch (uMsg) {
+	case WM_CLOSE: {
+		/* the application decides whether the window actually goes away */
+		swl_event_t e = { .type = SWL_EVENT_QUIT };
+		push_event(&e);
+		return 0;
+	}
+	case WM_KEYDOWN:
+	case WM_SYSKEYDOWN:
+		push_key(SWL_EVENT_KEYDOWN, wParam, lParam);
+		break;
+	case WM_KEYUP:
+	case WM_SYSKEYUP:
+		push_key(SWL_EVENT_KEYUP, wParam, lParam);
+		break;
+	case WM_MOUSEMOVE: {
+		swl_event_t e = { .type = SWL_EVENT_MOUSEMOVE };
+		e.mouse_move.x = (uint32_t)(int16_t)LOWORD(lParam);
+		e.mouse_move.y = (uint32_t)(int16_t)HIWORD(lParam);
+		e.mouse_move.oldx = window->mouse_x;
+		e.mouse_move.oldy = window->mouse_y;
+		window->mouse_x = e.mouse_move.x;
+		window->mouse_y = e.mouse_move.y;
+		push_event(&e);
+		return 0;
+	}
+	case WM_LBUTTONDOWN: push_button(SWL_EVENT_MOUSEDOWN, 1); return 0;
+	case WM_LBUTTONUP: push_button(SWL_EVENT_MOUSEUP, 1); return 0;
+	case WM_RBUTTONDOWN: push_button(SWL_EVENT_MOUSEDOWN, 2); return 0;
+	case WM_RBUTTONUP: push_button(SWL_EVENT_MOUSEUP, 2); return 0;
+	case WM_MBUTTONDOWN: push_button(SWL_EVENT_MOUSEDOWN, 3); return 0;
+	case WM_MBUTTONUP: push_button(SWL_EVENT_MOUSEUP, 3); return 0;
+	case WM_XBUTTONDOWN:
+		push_button(SWL_EVENT_MOUSEDOWN, HIWORD(wParam) == XBUTTON1 ? 4 : 5);
+		return TRUE;
+	case WM_XBUTTONUP:
+		push_button(SWL_EVENT_MOUSEUP, HIWORD(wParam) == XBUTTON1 ? 4 : 5);
+		return TRUE;
+	case WM_ENTERSIZEMOVE:
+		window->sizing = true;
+		window->enter_width = window->width;
+		window->enter_height = window->height;
+		break;
+	case WM_EXITSIZEMOVE: {
+		window->sizing = false;
+		if (type == SWL_EVENT_NONE) break;
+		swl_event_t e = { .type = SWL_EVENT_RESIZED };
+		e.resize.w = window->width;
+		e.resize.h = window->height;
+		e.resize.oldw = window->enter_width;
+		e.resize.oldh = window->enter_height;
+		push_event(&e);
+		break;
+	}
+	case WM_SIZE: {
+		if (wParam == SIZE_MINIMIZED) break;
+		uint32_t w = LOWORD(lParam);
+		uint32_t h = HIWORD(lParam);
+		push_resize(window, window->sizing ? SWL_EVENT_RESIZING : SWL_EVENT_RESIZED, w, h);
+		break;
+	}
+	case WM_PAINT: {
+		PAINTSTRUCT ps;
+		if (BeginPaint(hWnd, &ps) == NULL) break;
+		w32_swl_live_resize_paint(window, ps.hdc);
+		swl_event_t e = { .type = SWL_EVENT_PAINT };
+		e.paint.x0 = ps.rcPaint.left;
+		e.paint.y0 = ps.rcPaint.top;
+		e.paint.x1 = ps.rcPaint.right;
+		e.paint.y1 = ps.rcPaint.bottom;
+		EndPaint(hWnd, &ps);
+		push_event(&e);
+		return 0;
+	}
+	}
+
 	return DefWindowProcW(hWnd, uMsg, wParam, lParam);
 }
 
+bool w32_swl_dispatch_pending(void) {
+	MSG msg;
+	while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE) != 0) {
+		if (msg.message == WM_QUIT) {
+			swl_event_t e = { .type = SWL_EVENT_QUIT };
+			if (push_event(&e) == false) return false;
+			continue;
+		}
+		TranslateMessage(&msg);
+		DispatchMessageW(&msg);
+	}
+	return true;
+}
+
+int w32_swl_get_poll_fd(void) {
+	/*
+	 * Win32 has no file descriptor for the message queue. Reactors should wait
+	 * with MsgWaitForMultipleObjectsEx(..., QS_ALLINPUT, ...) and then call
+	 * swl_dispatch_pending.
+	 */
+	swl_error("Not supported on this backend.");
+	return -1;
+}
+
+static void pop_event(swl_event_t* event) {
+	queue* q = oldest_event;
+	*event = q->event;
+	oldest_event = q->next;
+	if (oldest_event == NULL) newest_event = NULL;
+	swl_pool_free(&event_pool, q);
+}
+
 bool w32_swl_get_event(swl_event_t* event) {
 	if (event == NULL) return swl_error("Parameter must not be NULL.");
 
+	if (oldest_event == NULL && w32_swl_dispatch_pending() == false) return false;
+
+	if (oldest_event == NULL) {
+		event->type = SWL_EVENT_NONE;
+		return true;
+	}
+
+	pop_event(event);
+	return true;
+}
+
+bool w32_swl_get_events(swl_event_t* events, uint32_t max, uint32_t* count) {
+	if (events == NULL) return swl_error("Parameter must not be NULL.");
+	if (count == NULL) return swl_error("Parameter must not be NULL.");
+
+	if (oldest_event == NULL && w32_swl_dispatch_pending() == false) return false;
+
+	uint32_t n = 0;
+	while (n < max && oldest_event != NULL) pop_event(&events[n++]);
+	*count = n;
+	return true;
+}
+
+bool w32_swl_set_event_mask(swl_window_t* window, uint32_t mask) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+
+	/* quit is never masked, otherwise the window could not be closed */
+	window->event_mask = mask | SWL_EVENT_MASK(SWL_EVENT_QUIT);
+	return true;
+}
+
+bool w32_swl_get_event_mask(swl_window_t* window, uint32_t* mask) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (mask == NULL) return swl_error("Parameter must not be NULL.");
+
+	*mask = window->event_mask;
+	return true;
+}
+
+bool w32_swl_get_event_stats(swl_event_stats_t* stats) {
+	if (stats == NULL) return swl_error("Parameter must not be NULL.");
+
+	stats->queued = events_queued;
+	stats->dropped = events_dropped;
+	stats->lost = events_lost;
 	return true;
 }
 
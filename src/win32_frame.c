@@ -0,0 +1,243 @@
+#include "swl_w32.h"
+
+#ifdef SWL_WINDOWS
+
+/*
+ * MODULE SUMMARY
+ *
+ * win32_frame.c - provides frame pacing on Win32.
+ *
+ * Everything is in microseconds on the QueryPerformanceCounter clock, which is
+ * also the clock DWM reports its timing in. When dwmapi loads and composition
+ * is on, the next vblank is predicted from DwmGetCompositionTimingInfo;
+ * otherwise we anchor a vblank grid to the first frame and step it by the
+ * monitor refresh rate.
+ *
+ * The input deadline is the predicted present minus a moving average of how
+ * long the application takes from swl_frame_begin until it starts presenting,
+ * so sampling input at the deadline leaves just enough time to make the
+ * vblank. swl_swap_buffers and swl_compositor_render note when presenting
+ * starts, because a vsynced SwapBuffers blocks until the flip and would
+ * otherwise count as render time.
+ *
+ * DWM only reports timing for the desktop as a whole, not for one window. At
+ * submit we note DWM's composition count; if by swl_frame_end DWM has composed
+ * exactly one more frame, that composition is the first one that could show
+ * ours, and its qpcFrameDisplayed is taken as when our frame was shown. DWM
+ * shows frames a fixed number of refreshes after the vblank they were composed
+ * for. That lag is learned separately from judging frames: a frame made it if
+ * it was shown no later than the predicted vblank plus the lag learned so far.
+ * The lag is the smallest seen over a window of confirmed frames, so it can go
+ * back up if DWM starts taking longer. Without such a composition we fall back
+ * to comparing the submit time with the predicted vblank.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+/* slack kept between the input deadline and the predicted present */
+#define FRAME_SLACK 500
+/* used when neither DWM nor GDI know the refresh rate */
+#define FRAME_DEFAULT_PERIOD 16667
+/* lag before the first frame DWM confirms */
+#define FRAME_LAG_UNKNOWN UINT64_MAX
+/* confirmed frames the lag is learned over before it is replaced */
+#define FRAME_LAG_WINDOW 120
+
+static uint64_t qpc_freq = 0;
+
+static uint64_t qpc_to_us(uint64_t qpc) {
+	if (qpc_freq == 0) {
+		LARGE_INTEGER f;
+		QueryPerformanceFrequency(&f);
+		qpc_freq = f.QuadPart;
+	}
+	return (qpc / qpc_freq) * 1000000 + (qpc % qpc_freq) * 1000000 / qpc_freq;
+}
+
+uint64_t w32_swl_get_time(void) {
+	LARGE_INTEGER t;
+	QueryPerformanceCounter(&t);
+	return qpc_to_us(t.QuadPart);
+}
+
+void w32_swl_frame_init(swl_window_t* window) {
+	window->frame.begin = 0;
+	window->frame.submit = 0;
+	window->frame.present = 0;
+	window->frame.compose = 0;
+	window->frame.lag = FRAME_LAG_UNKNOWN;
+	window->frame.lag_low = FRAME_LAG_UNKNOWN;
+	window->frame.lag_samples = 0;
+	window->frame.period = 0;
+	window->frame.anchor = 0;
+	window->frame.render = 0;
+	window->frame.frames = 0;
+	window->frame.missed = 0;
+	window->frame.confirmed = 0;
+	window->frame.latency_total = 0;
+	window->frame.latency_max = 0;
+}
+
+/* fills in period and a vblank time on the same grid; true if DWM provided them */
+static bool vblank_grid(swl_window_t* window, uint64_t now, uint64_t* period, uint64_t* vblank) {
+	DWM_TIMING_INFO ti = { .cbSize = sizeof(ti) };
+	if (w32_load_dwm() && w32_dwm.DwmGetCompositionTimingInfo(NULL, &ti) == S_OK && ti.qpcRefreshPeriod != 0) {
+		*period = qpc_to_us(ti.qpcRefreshPeriod);
+		*vblank = qpc_to_us(ti.qpcVBlank);
+		return true;
+	}
+
+	if (window->frame.period == 0) {
+		HDC hDC = GetDC(window->hWnd);
+		int hz = hDC ? GetDeviceCaps(hDC, VREFRESH) : 0;
+		if (hDC) ReleaseDC(window->hWnd, hDC);
+		/* 0 and 1 both mean "hardware default" */
+		window->frame.period = hz > 1 ? 1000000 / hz : FRAME_DEFAULT_PERIOD;
+		window->frame.anchor = now;
+	}
+	*period = window->frame.period;
+	*vblank = window->frame.anchor;
+	return false;
+}
+
+/* DWM's composition count, 0 if it is not available */
+static uint64_t dwm_compositions(void) {
+	DWM_TIMING_INFO ti = { .cbSize = sizeof(ti) };
+	if (w32_load_dwm() == false) return 0;
+	if (w32_dwm.DwmGetCompositionTimingInfo(NULL, &ti) != S_OK) return 0;
+	return ti.cFrame;
+}
+
+/*
+ * When the first composition after compose was displayed. DWM only reports its
+ * latest composition, so this fails once another one has happened since.
+ */
+static bool dwm_displayed(uint64_t compose, uint64_t submit, uint64_t* displayed) {
+	DWM_TIMING_INFO ti = { .cbSize = sizeof(ti) };
+	if (compose == 0 || w32_load_dwm() == false) return false;
+	if (w32_dwm.DwmGetCompositionTimingInfo(NULL, &ti) != S_OK) return false;
+	if (ti.cFrame != compose + 1 || ti.qpcFrameDisplayed == 0) return false;
+
+	uint64_t t = qpc_to_us(ti.qpcFrameDisplayed);
+	if (t < submit) return false;
+	*displayed = t;
+	return true;
+}
+
+/* first vblank on the grid strictly after t */
+static uint64_t next_vblank(uint64_t t, uint64_t period, uint64_t vblank) {
+	if (period == 0) return t;
+	if (vblank > t) return vblank;
+	return vblank + ((t - vblank) / period + 1) * period;
+}
+
+/*
+ * A frame later than the lowest lag seen in a while is a miss; replacing the
+ * lag every FRAME_LAG_WINDOW frames lets it rise again if DWM slows down.
+ */
+static void learn_lag(swl_window_t* window, uint64_t late) {
+	if (late < window->frame.lag) window->frame.lag = late;
+	if (late < window->frame.lag_low) window->frame.lag_low = late;
+	if (++window->frame.lag_samples < FRAME_LAG_WINDOW) return;
+	window->frame.lag = window->frame.lag_low;
+	window->frame.lag_low = FRAME_LAG_UNKNOWN;
+	window->frame.lag_samples = 0;
+}
+
+bool w32_swl_frame_begin(swl_window_t* window, swl_frame_t* frame) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (frame == NULL) return swl_error("Parameter must not be NULL.");
+
+	uint64_t now = w32_swl_get_time();
+	uint64_t period, vblank;
+	bool feedback = vblank_grid(window, now, &period, &vblank);
+
+	uint64_t present = next_vblank(now + window->frame.render, period, vblank);
+	uint64_t budget = window->frame.render + FRAME_SLACK;
+
+	window->frame.begin = now;
+	window->frame.submit = 0;
+	window->frame.compose = 0;
+	window->frame.present = present;
+
+	/* the vblank to make, plus however long DWM takes to show it */
+	uint64_t lag = window->frame.lag == FRAME_LAG_UNKNOWN ? 0 : window->frame.lag;
+
+	frame->frame = window->frame.frames;
+	frame->predicted_present = present + lag * period;
+	frame->input_deadline = present > now + budget ? present - budget : now;
+	frame->refresh_period = period;
+	frame->feedback = feedback;
+	return true;
+}
+
+bool w32_swl_frame_end(swl_window_t* window, bool* on_time) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (window->frame.begin == 0) return swl_error("swl_frame_begin was not called.");
+
+	/* presenting may block until the flip, so it does not count as rendering */
+	if (window->frame.submit == 0) w32_swl_frame_submit(window);
+	uint64_t submit = window->frame.submit;
+	uint64_t period, vblank;
+	vblank_grid(window, submit, &period, &vblank);
+
+	bool made_it;
+	uint64_t shown;
+	uint64_t displayed;
+	if (dwm_displayed(window->frame.compose, submit, &displayed)) {
+		uint64_t late = 0;
+		if (displayed > window->frame.present)
+			late = (displayed - window->frame.present + period / 2) / period;
+		/* judged by the lag learned so far, before this frame adds to it */
+		if (window->frame.lag == FRAME_LAG_UNKNOWN) made_it = submit <= window->frame.present;
+		else made_it = late <= window->frame.lag;
+		learn_lag(window, late);
+		shown = displayed;
+		window->frame.confirmed++;
+	} else {
+		/* a frame submitted after its vblank is shown on the next one instead */
+		made_it = submit <= window->frame.present;
+		shown = made_it ? window->frame.present : next_vblank(submit, period, vblank);
+		if (window->frame.lag != FRAME_LAG_UNKNOWN) shown += window->frame.lag * period;
+	}
+	uint64_t latency = shown - window->frame.begin;
+
+	uint64_t render = submit - window->frame.begin;
+	if (window->frame.frames == 0) {
+		window->frame.render = render;
+	} else {
+		/* moving average over roughly the last 8 frames */
+		window->frame.render = (window->frame.render * 7 + render) / 8;
+	}
+
+	window->frame.frames++;
+	if (made_it == false) window->frame.missed++;
+	window->frame.latency_total += latency;
+	if (latency > window->frame.latency_max) window->frame.latency_max = latency;
+	window->frame.begin = 0;
+
+	if (on_time) *on_time = made_it;
+	return true;
+}
+
+void w32_swl_frame_submit(swl_window_t* window) {
+	if (window == NULL || window->frame.begin == 0 || window->frame.submit != 0) return;
+	window->frame.submit = w32_swl_get_time();
+	window->frame.compose = dwm_compositions();
+}
+
+bool w32_swl_get_frame_stats(swl_window_t* window, swl_frame_stats_t* stats) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (stats == NULL) return swl_error("Parameter must not be NULL.");
+
+	stats->frames = window->frame.frames;
+	stats->missed = window->frame.missed;
+	stats->confirmed = window->frame.confirmed;
+	stats->latency_avg = window->frame.frames ? window->frame.latency_total / window->frame.frames : 0;
+	stats->latency_max = window->frame.latency_max;
+	stats->render_avg = window->frame.render;
+	return true;
+}
+
+#endif /* SWL_WINDOWS */
@@ -0,0 +1,265 @@
+#include "swl_w32.h"
+
+#ifdef SWL_WINDOWS
+
+/*
+ * MODULE SUMMARY
+ *
+ * win32_gl.c - provides OpenGL context creation on Win32 through WGL.
+ *
+ * Good pixel format selection and modern contexts need WGL_ARB_pixel_format
+ * and WGL_ARB_create_context, which can only be queried with a context
+ * current. So the first time a context is requested, we create a throwaway
+ * window and legacy context, grab the extension entry points, and tear it all
+ * down again. If the extensions are missing we fall back to ChoosePixelFormat
+ * and wglCreateContext.
+ *
+ * opengl32.dll itself is only loaded when the first context is created, see
+ * win32_load.c.
+ *
+ * Swap interval goes through WGL_EXT_swap_control. A negative interval asks
+ * for adaptive vsync, which needs WGL_EXT_swap_control_tear.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+/* from wglext.h, which MSVC doesn't ship */
+#define WGL_DRAW_TO_WINDOW_ARB 0x2001
+#define WGL_ACCELERATION_ARB 0x2003
+#define WGL_SUPPORT_OPENGL_ARB 0x2010
+#define WGL_DOUBLE_BUFFER_ARB 0x2011
+#define WGL_PIXEL_TYPE_ARB 0x2013
+#define WGL_COLOR_BITS_ARB 0x2014
+#define WGL_ALPHA_BITS_ARB 0x201B
+#define WGL_DEPTH_BITS_ARB 0x2022
+#define WGL_STENCIL_BITS_ARB 0x2023
+#define WGL_FULL_ACCELERATION_ARB 0x2027
+#define WGL_TYPE_RGBA_ARB 0x202B
+#define WGL_SAMPLE_BUFFERS_ARB 0x2041
+#define WGL_SAMPLES_ARB 0x2042
+#define WGL_FRAMEBUFFER_SRGB_CAPABLE_ARB 0x20A9
+#define WGL_CONTEXT_MAJOR_VERSION_ARB 0x2091
+#define WGL_CONTEXT_MINOR_VERSION_ARB 0x2092
+#define WGL_CONTEXT_FLAGS_ARB 0x2094
+#define WGL_CONTEXT_PROFILE_MASK_ARB 0x9126
+#define WGL_CONTEXT_DEBUG_BIT_ARB 0x0001
+#define WGL_CONTEXT_CORE_PROFILE_BIT_ARB 0x0001
+#define WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB 0x0002
+
+typedef BOOL (WINAPI *PFN_wglChoosePixelFormatARB)(HDC, const int*, const FLOAT*, UINT, int*, UINT*);
+typedef HGLRC (WINAPI *PFN_wglCreateContextAttribsARB)(HDC, HGLRC, const int*);
+typedef BOOL (WINAPI *PFN_wglSwapIntervalEXT)(int);
+typedef const char* (WINAPI *PFN_wglGetExtensionsStringARB)(HDC);
+
+static bool gl_loaded = false;
+static swl_pool_t context_pool;
+static swl_tracked_t context_pool_tracked;
+static PFN_wglChoosePixelFormatARB wglChoosePixelFormatARB;
+static PFN_wglCreateContextAttribsARB wglCreateContextAttribsARB;
+static PFN_wglSwapIntervalEXT wglSwapIntervalEXT;
+static bool has_swap_control_tear;
+
+/* no strstr without a CRT; list is space separated */
+static bool has_extension(const char* list, const char* name) {
+	if (list == NULL) return false;
+	while (*list) {
+		const char* a = list;
+		const char* b = name;
+		while (*b && *a == *b) { a++; b++; }
+		if (*b == '\0' && (*a == ' ' || *a == '\0')) return true;
+		while (*list && *list != ' ') list++;
+		while (*list == ' ') list++;
+	}
+	return false;
+}
+
+static bool load_wgl(void) {
+	HWND hWnd = CreateWindowExW(0, L"swl", L"", WS_OVERLAPPEDWINDOW, 0, 0, 1, 1, HWND_DESKTOP, NULL, GetModuleHandle(NULL), NULL);
+	if (hWnd == NULL) return swl_error("CreateWindowExW failed.");
+	HDC hDC = GetDC(hWnd);
+
+	PIXELFORMATDESCRIPTOR pfd = {
+		.nSize = sizeof(pfd),
+		.nVersion = 1,
+		.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER,
+		.iPixelType = PFD_TYPE_RGBA,
+		.cColorBits = 32,
+	};
+	int format = ChoosePixelFormat(hDC, &pfd);
+	HGLRC dummy = NULL;
+	if (format != 0 && SetPixelFormat(hDC, format, &pfd) != FALSE)
+		dummy = w32_wgl.wglCreateContext(hDC);
+	if (dummy == NULL || w32_wgl.wglMakeCurrent(hDC, dummy) == FALSE) {
+		if (dummy) w32_wgl.wglDeleteContext(dummy);
+		ReleaseDC(hWnd, hDC);
+		DestroyWindow(hWnd);
+		return swl_error("Failed to create dummy GL context.");
+	}
+
+	PFN_wglGetExtensionsStringARB wglGetExtensionsStringARB =
+		(PFN_wglGetExtensionsStringARB)(void*)w32_wgl.wglGetProcAddress("wglGetExtensionsStringARB");
+	const char* exts = wglGetExtensionsStringARB ? wglGetExtensionsStringARB(hDC) : NULL;
+
+	if (has_extension(exts, "WGL_ARB_pixel_format"))
+		wglChoosePixelFormatARB = (PFN_wglChoosePixelFormatARB)(void*)w32_wgl.wglGetProcAddress("wglChoosePixelFormatARB");
+	if (has_extension(exts, "WGL_ARB_create_context"))
+		wglCreateContextAttribsARB = (PFN_wglCreateContextAttribsARB)(void*)w32_wgl.wglGetProcAddress("wglCreateContextAttribsARB");
+	if (has_extension(exts, "WGL_EXT_swap_control"))
+		wglSwapIntervalEXT = (PFN_wglSwapIntervalEXT)(void*)w32_wgl.wglGetProcAddress("wglSwapIntervalEXT");
+	has_swap_control_tear = has_extension(exts, "WGL_EXT_swap_control_tear");
+
+	w32_wgl.wglMakeCurrent(NULL, NULL);
+	w32_wgl.wglDeleteContext(dummy);
+	ReleaseDC(hWnd, hDC);
+	DestroyWindow(hWnd);
+
+	/* only once nothing can fail anymore, so retries don't leak pools */
+	context_pool = swl_new_pool(sizeof(swl_gl_context_t));
+	if (context_pool.arena.base == NULL)
+		return swl_error("Failed to allocate GL context pool.");
+	swl_track_pool(&context_pool_tracked, &context_pool, SWL_MEMORY_GL);
+
+	gl_loaded = true;
+	return true;
+}
+
+static int choose_format(HDC hDC, const swl_gl_desc_t* desc) {
+	if (wglChoosePixelFormatARB) {
+		int attribs[] = {
+			WGL_DRAW_TO_WINDOW_ARB, TRUE,
+			WGL_SUPPORT_OPENGL_ARB, TRUE,
+			WGL_DOUBLE_BUFFER_ARB, TRUE,
+			WGL_ACCELERATION_ARB, WGL_FULL_ACCELERATION_ARB,
+			WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,
+			WGL_COLOR_BITS_ARB, desc->color_bits,
+			WGL_ALPHA_BITS_ARB, desc->alpha_bits,
+			WGL_DEPTH_BITS_ARB, desc->depth_bits,
+			WGL_STENCIL_BITS_ARB, desc->stencil_bits,
+			WGL_SAMPLE_BUFFERS_ARB, desc->samples > 1,
+			WGL_SAMPLES_ARB, desc->samples > 1 ? desc->samples : 0,
+			/* keep this pair last so it can be cut off when not wanted */
+			WGL_FRAMEBUFFER_SRGB_CAPABLE_ARB, TRUE,
+			0,
+		};
+		if (desc->srgb == false) attribs[22] = 0;
+
+		int format = 0;
+		UINT count = 0;
+		if (wglChoosePixelFormatARB(hDC, attribs, NULL, 1, &format, &count) != FALSE && count > 0)
+			return format;
+	}
+
+	PIXELFORMATDESCRIPTOR pfd = {
+		.nSize = sizeof(pfd),
+		.nVersion = 1,
+		.dwFlags = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER,
+		.iPixelType = PFD_TYPE_RGBA,
+		.cColorBits = desc->color_bits,
+		.cAlphaBits = desc->alpha_bits,
+		.cDepthBits = desc->depth_bits,
+		.cStencilBits = desc->stencil_bits,
+	};
+	return ChoosePixelFormat(hDC, &pfd);
+}
+
+swl_gl_context_t* w32_swl_create_gl_context(swl_window_t* window, const swl_gl_desc_t* desc) {
+	if (window == NULL) return (swl_gl_context_t*)swl_error("Parameter must not be NULL.");
+	if (desc == NULL) return (swl_gl_context_t*)swl_error("Parameter must not be NULL.");
+	if (w32_load_wgl() == false) return NULL;
+	if (gl_loaded == false && load_wgl() == false) return NULL;
+
+	/* the swl window class is CS_OWNDC, so this DC lives as long as the window */
+	HDC hDC = GetDC(window->hWnd);
+	if (hDC == NULL) return (swl_gl_context_t*)swl_error("GetDC failed.");
+
+	int format = choose_format(hDC, desc);
+	if (format == 0) return (swl_gl_context_t*)swl_error("No matching pixel format.");
+
+	/*
+	 * A window's pixel format can only be set once. Creating another context
+	 * for the same window, e.g. retrying with a lower version, is fine as long
+	 * as it wants the same format.
+	 */
+	int current = GetPixelFormat(hDC);
+	if (current == 0) {
+		PIXELFORMATDESCRIPTOR pfd;
+		DescribePixelFormat(hDC, format, sizeof(pfd), &pfd);
+		if (SetPixelFormat(hDC, format, &pfd) == FALSE)
+			return (swl_gl_context_t*)swl_error("SetPixelFormat failed.");
+	} else if (current != format) {
+		return (swl_gl_context_t*)swl_error("Window already has a different pixel format.");
+	}
+
+	HGLRC hGLRC = NULL;
+	if (wglCreateContextAttribsARB && desc->major != 0) {
+		int attribs[] = {
+			WGL_CONTEXT_MAJOR_VERSION_ARB, desc->major,
+			WGL_CONTEXT_MINOR_VERSION_ARB, desc->minor,
+			WGL_CONTEXT_PROFILE_MASK_ARB, desc->core_profile ? WGL_CONTEXT_CORE_PROFILE_BIT_ARB : WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+			WGL_CONTEXT_FLAGS_ARB, desc->debug ? WGL_CONTEXT_DEBUG_BIT_ARB : 0,
+			0,
+		};
+		hGLRC = wglCreateContextAttribsARB(hDC, NULL, attribs);
+	} else {
+		hGLRC = w32_wgl.wglCreateContext(hDC);
+	}
+	if (hGLRC == NULL) return (swl_gl_context_t*)swl_error("Failed to create GL context.");
+
+	swl_gl_context_t* r = swl_pool_alloc(&context_pool);
+	if (r == NULL) {
+		w32_wgl.wglDeleteContext(hGLRC);
+		return (swl_gl_context_t*)swl_error("Failed to allocate GL context.");
+	}
+	r->window = window;
+	r->hDC = hDC;
+	r->hGLRC = hGLRC;
+	return r;
+}
+
+bool w32_swl_destroy_gl_context(swl_gl_context_t* context) {
+	if (context == NULL) return swl_error("Parameter must not be NULL.");
+
+	if (w32_wgl.wglGetCurrentContext() == context->hGLRC) w32_wgl.wglMakeCurrent(NULL, NULL);
+	BOOL r = w32_wgl.wglDeleteContext(context->hGLRC);
+	swl_pool_free(&context_pool, context);
+	if (r == FALSE) return swl_error("wglDeleteContext failed.");
+	return true;
+}
+
+bool w32_swl_make_current(swl_gl_context_t* context) {
+	BOOL r;
+	if (context == NULL) {
+		/* nothing can be current before opengl32 is loaded */
+		if (w32_wgl.loaded == false) return true;
+		r = w32_wgl.wglMakeCurrent(NULL, NULL);
+	} else {
+		r = w32_wgl.wglMakeCurrent(context->hDC, context->hGLRC);
+	}
+	if (r == FALSE) return swl_error("wglMakeCurrent failed.");
+	return true;
+}
+
+bool w32_swl_swap_buffers(swl_gl_context_t* context) {
+	if (context == NULL) return swl_error("Parameter must not be NULL.");
+
+	w32_swl_frame_submit(context->window);
+	if (SwapBuffers(context->hDC) == FALSE) return swl_error("SwapBuffers failed.");
+	return true;
+}
+
+bool w32_swl_set_swap_interval(swl_gl_context_t* context, int interval) {
+	if (context == NULL) return swl_error("Parameter must not be NULL.");
+	if (w32_wgl.wglGetCurrentContext() != context->hGLRC)
+		return swl_error("Context must be current.");
+	if (wglSwapIntervalEXT == NULL)
+		return swl_error("Swap interval control is not supported.");
+	if (interval < 0 && has_swap_control_tear == false)
+		return swl_error("Adaptive vsync is not supported.");
+
+	if (wglSwapIntervalEXT(interval) == FALSE)
+		return swl_error("wglSwapIntervalEXT failed.");
+	return true;
+}
+
+#endif /* SWL_WINDOWS */
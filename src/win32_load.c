@@ -0,0 +1,71 @@
+#include "swl_w32.h"
+
+#ifdef SWL_WINDOWS
+
+/*
+ * MODULE SUMMARY
+ *
+ * win32_load.c - loads optional system libraries on first use.
+ *
+ * Linking dwmapi and opengl32 directly makes every program pay for loading
+ * them at startup, even if it never makes a window transparent or creates a
+ * GL context. Instead, each library gets a table of function pointers that is
+ * filled in with GetProcAddress the first time a feature needs it. user32,
+ * kernel32 and gdi32 are needed by everything and stay linked.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+w32_dwm_t w32_dwm;
+w32_wgl_t w32_wgl;
+
+#define LOAD_SYMBOL(table, x) do { \
+	*(FARPROC*)&table.x = GetProcAddress(table.module, #x); \
+	if (table.x == NULL) return swl_error("Failed to load " #x "."); \
+} while (0)
+
+bool w32_load_dwm(void) {
+	if (w32_dwm.loaded) return true;
+	if (w32_dwm.failed) return swl_error("dwmapi.dll is not available.");
+
+	w32_dwm.module = LoadLibraryW(L"dwmapi.dll");
+	if (w32_dwm.module == NULL) {
+		w32_dwm.failed = true;
+		return swl_error("dwmapi.dll is not available.");
+	}
+
+	/* stays set if a symbol is missing */
+	w32_dwm.failed = true;
+	LOAD_SYMBOL(w32_dwm, DwmEnableBlurBehindWindow);
+	LOAD_SYMBOL(w32_dwm, DwmGetCompositionTimingInfo);
+	w32_dwm.failed = false;
+
+	w32_dwm.loaded = true;
+	return true;
+}
+
+bool w32_load_wgl(void) {
+	if (w32_wgl.loaded) return true;
+	if (w32_wgl.failed) return swl_error("opengl32.dll is not available.");
+
+	w32_wgl.module = LoadLibraryW(L"opengl32.dll");
+	if (w32_wgl.module == NULL) {
+		w32_wgl.failed = true;
+		return swl_error("opengl32.dll is not available.");
+	}
+
+	/* stays set if a symbol is missing */
+	w32_wgl.failed = true;
+	LOAD_SYMBOL(w32_wgl, wglCreateContext);
+	LOAD_SYMBOL(w32_wgl, wglDeleteContext);
+	LOAD_SYMBOL(w32_wgl, wglMakeCurrent);
+	LOAD_SYMBOL(w32_wgl, wglGetCurrentContext);
+	LOAD_SYMBOL(w32_wgl, wglGetProcAddress);
+	w32_wgl.failed = false;
+
+	w32_wgl.loaded = true;
+	return true;
+}
+
+#endif /* SWL_WINDOWS */
@@ -10,38 +10,71 @@
  * Because we are going without a standard library, we need to make our own
  * allocators. We use VirtualAlloc to reserve and commit pages.
  *
+ * Reserve and initial commit sizes come from swl_memory_config (see memory.c).
+ * Reservations are rounded to the allocation granularity and commits to the
+ * page size, both asked from the system once. Commits double as the arena
+ * grows, and swl_trim_arena decommits everything past the last page in use.
+ *
  * AUTHOR: Finxx
  * DATE: 2025.05.10
  */
 
-#define ARENA_RESERVE 32 * 1024 * 1024
-#define ARENA_INITIAL_COMMIT 32 * 1024
+static ptrdiff_t page_size = 0;
+static ptrdiff_t granularity = 0;
+
+/* both are powers of two */
+static ptrdiff_t round_to(ptrdiff_t n, ptrdiff_t to) {
+	return (n + to - 1) & ~(to - 1);
+}
+
+/* arenas can be made before swl_init, so this is asked on first use */
+static void query_sizes(void) {
+	if (page_size != 0) return;
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	page_size = si.dwPageSize;
+	granularity = si.dwAllocationGranularity;
+}
+
+static ptrdiff_t round_page(ptrdiff_t n) {
+	return round_to(n, page_size);
+}
 
 swl_arena_t swl_new_arena(void) {
 	swl_arena_t zero = {0};
 	swl_arena_t arena = {0};
-	arena.base = VirtualAlloc(NULL, ARENA_RESERVE, MEM_RESERVE, PAGE_READWRITE);
+	query_sizes();
+	ptrdiff_t reserve = round_to((ptrdiff_t)swl_memory_config.arena_reserve, granularity);
+	ptrdiff_t commit = round_page((ptrdiff_t)swl_memory_config.arena_commit);
+
+	arena.base = VirtualAlloc(NULL, reserve, MEM_RESERVE, PAGE_READWRITE);
 	if (arena.base == NULL) return zero;
 	
-	void* foo = VirtualAlloc(arena.base, ARENA_INITIAL_COMMIT, MEM_COMMIT, PAGE_READWRITE);
+	void* foo = VirtualAlloc(arena.base, commit, MEM_COMMIT, PAGE_READWRITE);
 	if (foo == NULL) {
 		VirtualFree(arena.base, 0, MEM_RELEASE);
 		return zero;
 	}
 	
 	arena.pos = 0;
-	arena.reserved = ARENA_RESERVE;
-	arena.committed = ARENA_INITIAL_COMMIT;
+	arena.reserved = reserve;
+	arena.committed = commit;
 	return arena;
 }
 
 void* swl_push_arena(swl_arena_t* arena, ptrdiff_t amnt) {
 	if (arena == NULL) return NULL;
 	if (amnt == 0) return NULL;
+	if (arena->pos + amnt > arena->reserved) return NULL;
 	
-	while (arena->pos + amnt >= arena->committed) {
-		ptrdiff_t newsize = arena->committed * 2;
-		void* foo = VirtualAlloc(arena, newsize, MEM_COMMIT, PAGE_READWRITE);
+	if (arena->pos + amnt > arena->committed) {
+		/* committed can be 0 after a trim */
+		ptrdiff_t newsize = arena->committed;
+		if (newsize == 0) newsize = round_page((ptrdiff_t)swl_memory_config.arena_commit);
+		while (newsize < arena->pos + amnt) newsize *= 2;
+		if (newsize > arena->reserved) newsize = arena->reserved;
+
+		void* foo = VirtualAlloc(arena->base, newsize, MEM_COMMIT, PAGE_READWRITE);
 		if (foo == NULL) {
 			return NULL;
 		}
@@ -68,8 +101,24 @@ void swl_clear_arena(swl_arena_t* arena) {
 
 void swl_free_arena(swl_arena_t* arena) {
 	if (arena == NULL) return;
+	if (arena->base == NULL) return;
 	
-	VirtualFree(arena, 0, MEM_RELEASE);
+	VirtualFree(arena->base, 0, MEM_RELEASE);
+	arena->base = NULL;
+	arena->pos = 0;
+	arena->reserved = 0;
+	arena->committed = 0;
+}
+
+void swl_trim_arena(swl_arena_t* arena) {
+	if (arena == NULL) return;
+	if (arena->base == NULL) return;
+
+	ptrdiff_t keep = round_page(arena->pos);
+	if (keep >= arena->committed) return;
+
+	if (VirtualFree(SWL_ADD_OFFSET(arena->base, keep), arena->committed - keep, MEM_DECOMMIT) != 0)
+		arena->committed = keep;
 }
 
 #endif /* SWL_WINDOWS */
@@ -0,0 +1,208 @@
+#include "swl_w32.h"
+
+#ifdef SWL_WINDOWS
+
+/*
+ * MODULE SUMMARY
+ *
+ * win32_resize.c - provides the live resize fast path on Win32.
+ *
+ * While the user drags a window edge, Win32 runs its own modal loop and the
+ * application gets no chance to render, so the window shows the class brush
+ * or garbage. When live resize is on, wndproc paints the last frame the
+ * window's compositor presented instead, rescaled (or cropped and padded) to
+ * the current size, until the application renders a frame at that size.
+ *
+ * Scaling goes into a buffer owned by the compositor and is blitted with one
+ * SetDIBitsToDevice. The bilinear kernel uses SSE2 where it is available and
+ * 7-bit fixed point weights so every intermediate fits in 16 bits.
+ *
+ * AUTHOR: Finxx
+ * DATE: 2026.10.19
+ */
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define RESIZE_SSE2
+#endif
+
+bool w32_swl_set_window_live_resize(swl_window_t* window, swl_live_resize_t mode) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (mode > SWL_LIVE_RESIZE_CROP) return swl_error("Invalid live resize mode.");
+
+	window->live_resize = mode;
+	return true;
+}
+
+bool w32_swl_get_window_live_resize(swl_window_t* window, swl_live_resize_t* mode) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	if (mode == NULL) return swl_error("Parameter must not be NULL.");
+
+	*mode = window->live_resize;
+	return true;
+}
+
+/* the frame currently on screen, if one has been presented */
+static bool shown_frame(swl_compositor_t* c, const uint32_t** pixels, uint32_t* w, uint32_t* h) {
+	if (c->last_bitmap) {
+		*pixels = c->last_pixels;
+		*w = c->last_width;
+		*h = c->last_height;
+		return true;
+	}
+	if (c->presented) {
+		*pixels = c->pixels;
+		*w = c->width;
+		*h = c->height;
+		return true;
+	}
+	return false;
+}
+
+static void scale_crop(const uint32_t* src, uint32_t sw, uint32_t sh, uint32_t* dst, uint32_t dw, uint32_t dh) {
+	for (uint32_t y = 0; y < dh; y++) {
+		uint32_t* d = dst + (ptrdiff_t)y * dw;
+		uint32_t x = 0;
+		if (y < sh) {
+			const uint32_t* s = src + (ptrdiff_t)y * sw;
+			for (; x < dw && x < sw; x++) d[x] = s[x];
+		}
+		for (; x < dw; x++) d[x] = 0;
+	}
+}
+
+static void scale_nearest(const uint32_t* src, uint32_t sw, uint32_t sh, uint32_t* dst, uint32_t dw, uint32_t dh) {
+	/* 16.16 fixed point, sampling at pixel centres; 64-bit so any size fits */
+	uint64_t xstep = ((uint64_t)sw << 16) / dw;
+	uint64_t ystep = ((uint64_t)sh << 16) / dh;
+	uint64_t sy = ystep / 2;
+	for (uint32_t y = 0; y < dh; y++, sy += ystep) {
+		const uint32_t* s = src + (ptrdiff_t)(sy >> 16) * sw;
+		uint32_t* d = dst + (ptrdiff_t)y * dw;
+		uint64_t sx = xstep / 2;
+		for (uint32_t x = 0; x < dw; x++, sx += xstep)
+			d[x] = s[sx >> 16];
+	}
+}
+
+/* maps a destination coordinate to a source coordinate and 7-bit weight */
+static void bilinear_coord(int64_t pos, uint32_t size, uint32_t* i0, uint32_t* i1, uint32_t* weight) {
+	if (pos < 0) pos = 0;
+	uint32_t i = (uint32_t)((uint64_t)pos >> 16);
+	if (i >= size - 1) {
+		*i0 = size - 1;
+		*i1 = size - 1;
+		*weight = 0;
+		return;
+	}
+	*i0 = i;
+	*i1 = i + 1;
+	*weight = (uint32_t)((uint64_t)pos >> 9) & 127;
+}
+
+static void scale_bilinear(const uint32_t* src, uint32_t sw, uint32_t sh, uint32_t* dst, uint32_t dw, uint32_t dh) {
+	int64_t xstep = (int64_t)(((uint64_t)sw << 16) / dw);
+	int64_t ystep = (int64_t)(((uint64_t)sh << 16) / dh);
+	int64_t ypos = ystep / 2 - 0x8000;
+
+#ifdef RESIZE_SSE2
+	__m128i zero = _mm_setzero_si128();
+#endif
+
+	for (uint32_t y = 0; y < dh; y++, ypos += ystep) {
+		uint32_t y0, y1, fy;
+		bilinear_coord(ypos, sh, &y0, &y1, &fy);
+		const uint32_t* r0 = src + (ptrdiff_t)y0 * sw;
+		const uint32_t* r1 = src + (ptrdiff_t)y1 * sw;
+		uint32_t* d = dst + (ptrdiff_t)y * dw;
+
+#ifdef RESIZE_SSE2
+		__m128i wy = _mm_set1_epi16((short)fy);
+#endif
+		int64_t xpos = xstep / 2 - 0x8000;
+		for (uint32_t x = 0; x < dw; x++, xpos += xstep) {
+			uint32_t x0, x1, fx;
+			bilinear_coord(xpos, sw, &x0, &x1, &fx);
+
+#ifdef RESIZE_SSE2
+			/* lanes 0-3 are the left column's channels, lanes 4-7 the right's */
+			__m128i top = _mm_unpacklo_epi8(_mm_unpacklo_epi32(
+				_mm_cvtsi32_si128(r0[x0]), _mm_cvtsi32_si128(r0[x1])), zero);
+			__m128i bot = _mm_unpacklo_epi8(_mm_unpacklo_epi32(
+				_mm_cvtsi32_si128(r1[x0]), _mm_cvtsi32_si128(r1[x1])), zero);
+			__m128i v = _mm_add_epi16(top, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(bot, top), wy), 7));
+			__m128i right = _mm_srli_si128(v, 8);
+			__m128i h = _mm_add_epi16(v, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(right, v), _mm_set1_epi16((short)fx)), 7));
+			d[x] = (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(h, zero));
+#else
+			uint32_t p00 = r0[x0], p01 = r0[x1], p10 = r1[x0], p11 = r1[x1];
+			uint32_t out = 0;
+			for (int shift = 0; shift < 32; shift += 8) {
+				int32_t a = (p00 >> shift) & 0xFF, b = (p01 >> shift) & 0xFF;
+				int32_t c = (p10 >> shift) & 0xFF, e = (p11 >> shift) & 0xFF;
+				int32_t l = a + (((c - a) * (int32_t)fy) >> 7);
+				int32_t r = b + (((e - b) * (int32_t)fy) >> 7);
+				out |= (uint32_t)(l + (((r - l) * (int32_t)fx) >> 7)) << shift;
+			}
+			d[x] = out;
+#endif
+		}
+	}
+}
+
+bool w32_swl_live_resize_ready(swl_window_t* window) {
+	if (window->live_resize == SWL_LIVE_RESIZE_OFF) return false;
+	swl_compositor_t* c = window->compositor;
+	/* until a frame is presented there is nothing to paint, so let it erase */
+	return c != NULL && (c->presented || c->last_bitmap != NULL);
+}
+
+bool w32_swl_live_resize_paint(swl_window_t* window, HDC hDC) {
+	if (window->live_resize == SWL_LIVE_RESIZE_OFF) return false;
+	swl_compositor_t* c = window->compositor;
+	if (c == NULL) return false;
+
+	const uint32_t* src;
+	uint32_t sw, sh;
+	if (shown_frame(c, &src, &sw, &sh) == false) return false;
+
+	RECT rc;
+	if (GetClientRect(window->hWnd, &rc) == 0) return false;
+	uint32_t dw = rc.right - rc.left;
+	uint32_t dh = rc.bottom - rc.top;
+	/* the presented frame already fits, nothing to fix up */
+	if (dw == 0 || dh == 0 || (dw == sw && dh == sh && c->last_bitmap == NULL)) return false;
+
+	ptrdiff_t size = (ptrdiff_t)dw * dh * sizeof(uint32_t);
+	if (size > c->scale_capacity) {
+		if (c->scale) VirtualFree(c->scale, 0, MEM_RELEASE);
+		c->tracked.external -= c->scale_capacity;
+		c->scale = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		c->scale_capacity = c->scale ? size : 0;
+		c->tracked.external += c->scale_capacity;
+		if (c->scale == NULL) return false;
+	}
+
+	/* the DIB sections may still have GDI writes batched */
+	GdiFlush();
+	switch (window->live_resize) {
+	case SWL_LIVE_RESIZE_NEAREST: scale_nearest(src, sw, sh, c->scale, dw, dh); break;
+	case SWL_LIVE_RESIZE_BILINEAR: scale_bilinear(src, sw, sh, c->scale, dw, dh); break;
+	default: scale_crop(src, sw, sh, c->scale, dw, dh); break;
+	}
+
+	BITMAPINFO bmi = {
+		.bmiHeader = {
+			.biSize = sizeof(BITMAPINFOHEADER),
+			.biWidth = dw,
+			.biHeight = -(LONG)dh,
+			.biPlanes = 1,
+			.biBitCount = 32,
+			.biCompression = BI_RGB,
+		},
+	};
+	SetDIBitsToDevice(hDC, 0, 0, dw, dh, 0, 0, 0, dh, c->scale, &bmi, DIB_RGB_COLORS);
+	return true;
+}
+
+#endif /* SWL_WINDOWS */
@@ -21,21 +21,21 @@
  * DATE: 2025.05.09
  */
 
-#include <dwmapi.h>
-
 static HMODULE g_hmod;
 static swl_pool_t window_pool;
+static swl_tracked_t window_pool_tracked;
 static swl_arena_t scratch;
+static swl_tracked_t scratch_tracked;
 static DWM_BLURBEHIND blurbehind;
 
 static PWSTR towidechar(swl_arena_t* arena, char* str) {
 	int len = MultiByteToWideChar(CP_UTF8, 0, str, -1, NULL, 0);
 	if (len == 0) return NULL;
-	PWSTR r = swl_push_arena(arena, len);
+	PWSTR r = swl_push_arena(arena, len * sizeof(WCHAR));
 	if (r == NULL) return NULL;
 	int foo = MultiByteToWideChar(CP_UTF8, 0, str, -1, r, len);
 	if (foo == 0) {
-		swl_pop_arena(arena, len);
+		swl_pop_arena(arena, len * sizeof(WCHAR));
 		return NULL;
 	}
 	return r;
@@ -63,6 +63,7 @@ bool w32_swl_init(void) {
 	
 	WNDCLASSEXW wcex = {
 		.cbSize = sizeof(wcex),
+		.style = CS_OWNDC,
 		.hInstance = g_hmod,
 		.hCursor = LoadCursorA(NULL, IDC_ARROW),
 		.lpszClassName = L"swl",
@@ -75,10 +76,12 @@ bool w32_swl_init(void) {
 	window_pool = swl_new_pool(sizeof(swl_window_t));
 	if (window_pool.arena.base == NULL)
 		return swl_error("Failed to allocate window pool.");
+	swl_track_pool(&window_pool_tracked, &window_pool, SWL_MEMORY_WINDOWS);
 
 	scratch = swl_new_arena();
 	if (scratch.base == NULL)
 		return swl_error("Failed to allocate scratch arena.");
+	swl_track_arena(&scratch_tracked, &scratch, SWL_MEMORY_SCRATCH);
 
 	blurbehind.dwFlags = DWM_BB_BLURREGION | DWM_BB_ENABLE;
 	blurbehind.hRgnBlur = CreateRectRgn(-1, -1, 0, 0);
@@ -87,14 +90,42 @@ bool w32_swl_init(void) {
 }
 
 swl_window_t* w32_swl_create_window(void) {
-	HWND hWnd = CreateWindowExW(0, L"swl", L"", WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, HWND_DESKTOP, NULL, g_hmod, NULL);
-
 	swl_window_t* r = swl_pool_alloc(&window_pool);
-	r->hWnd = hWnd;
+	if (r == NULL) return (swl_window_t*)swl_error("Failed to allocate window.");
+	r->hWnd = NULL;
 	r->transparent = false;
+	r->sizing = false;
+	r->width = 0;
+	r->height = 0;
+	r->mouse_x = 0;
+	r->mouse_y = 0;
+	r->event_mask = SWL_EVENT_MASK_ALL;
+	r->live_resize = SWL_LIVE_RESIZE_OFF;
+	r->compositor = NULL;
+	w32_swl_frame_init(r);
+
+	/* wndproc picks r up from lpParam on WM_NCCREATE */
+	HWND hWnd = CreateWindowExW(0, L"swl", L"", WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, CW_USEDEFAULT, HWND_DESKTOP, NULL, g_hmod, r);
+	if (hWnd == NULL) {
+		swl_pool_free(&window_pool, r);
+		return (swl_window_t*)swl_error("CreateWindowExW failed.");
+	}
+	r->hWnd = hWnd;
 	return r;
 }
 
+bool w32_swl_destroy_window(swl_window_t* window) {
+	if (window == NULL) return swl_error("Parameter must not be NULL.");
+	/* the compositor keeps a pointer to the window and draws into it */
+	if (window->compositor != NULL)
+		return swl_error("Window still has a compositor.");
+
+	/* WM_DESTROY and WM_NCDESTROY still reach wndproc with window intact */
+	if (DestroyWindow(window->hWnd) == 0) return swl_error("DestroyWindow failed.");
+	swl_pool_free(&window_pool, window);
+	return true;
+}
+
 bool w32_swl_set_window_title(swl_window_t* window, const char* title) {
 	if (window == NULL) return swl_error("Parameter must not be NULL.");
 	if (title == NULL) return swl_error("Parameter must not be NULL.");
@@ -153,7 +184,8 @@ bool w32_swl_set_window_transparent(swl_window_t* window, bool transparent) {
 	if (window == NULL) return swl_error("Parameter must not be NULL.");
 
 	blurbehind.fEnable = transparent;
-	HRESULT hr = DwmEnableBlurBehindWindow(window->hWnd, &blurbehind);
+	if (w32_load_dwm() == false) return false;
+	HRESULT hr = w32_dwm.DwmEnableBlurBehindWindow(window->hWnd, &blurbehind);
 	if (hr != S_OK) return swl_error("DwmEnableBlurBehindWindow failed.");
 	window->transparent = transparent;
 	return true;
@@ -195,7 +227,8 @@ char* w32_swl_get_window_title(swl_window_t* window) {
 	if (len == 0) return "";
 
 	swl_clear_arena(&scratch);
-	PWSTR str = swl_push_arena(&scratch, len + 2);
+	PWSTR str = swl_push_arena(&scratch, (len + 2) * sizeof(WCHAR));
+	if (str == NULL) return (char*)swl_error("Failed to allocate title.");
 	int err = GetWindowTextW(window->hWnd, str, len + 2);
 	if (err == 0) return (char*)swl_error("GetWindowTextW failed.");
 	char* r = toutf8(&scratch, str);